@@ -0,0 +1,184 @@
+/*
+ * Batch mode shared by p1 - p5: many graph files in one process.
+ *
+ *   ./p1 ../dataset/ [more files or directories] [--jobs=N] [--output=dir] [--format=...]
+ *
+ * Directories are searched recursively for .txt and .csr graphs; a .csr
+ * file stands in for the .txt of the same name, as in the run_p*_only.py
+ * scripts. The files go to a pool of N threads (default: one per hardware
+ * thread), largest first, so that a big file does not start last and hold
+ * up the end of the batch.
+ *
+ * Each file's usual output (in the chosen --format) is written to
+ * dir/<category>/<name>.txt|.json|.bin with --output=dir, and discarded
+ * without it. When all files are done, one CSV row per file goes to stdout,
+ * in path order, with the columns of the scripts' p*_results.csv:
+ *   algorithm,category,file,n,m,time,exitcode,output
+ * `file` is always <category>/<name>, the dataset-relative form the scripts
+ * write, whichever directory was given, and names the .txt even when its
+ * .csr stood in. `time` is the wall time of load, compute and output for
+ * that file, and n and m are taken from the file's header.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "csr_graph.h"
+#include "result_output.h"
+
+struct BatchFile {
+    std::string path;     // the file that is run
+    std::string category; // name of the directory holding it
+    std::string file;     // <category>/<name> of the .txt it stands for
+    uintmax_t bytes = 0;
+    int64_t n = 0, m = 0; // header counts
+    std::string output;   // per-file output path, empty: discarded
+    double seconds = 0;
+    int exitCode = 0;
+};
+
+/**
+ * @brief The batch entry of graph file p. A .csr with a .txt of the same
+ * name is reported under the .txt's name, like the scripts do.
+ */
+inline BatchFile makeBatchFile(const std::filesystem::path& p) {
+    namespace fs = std::filesystem;
+    BatchFile f;
+    f.path = p.string();
+    f.category = p.parent_path().filename().string();
+    fs::path name = p.filename(), txt = p;
+    std::error_code ec;
+    if (p.extension() == ".csr" && fs::exists(txt.replace_extension(".txt"), ec)) {
+        name.replace_extension(".txt");
+    }
+    f.file = (fs::path(f.category) / name).string();
+    return f;
+}
+
+/**
+ * @brief Expands the batch inputs into the list of graph files, sorted by
+ * path. Returns false if an input does not exist.
+ */
+inline bool collectBatchFiles(const std::vector<const char*>& inputs, std::vector<BatchFile>& files) {
+    namespace fs = std::filesystem;
+    for (const char* input : inputs) {
+        std::error_code ec;
+        fs::path root(input);
+        if (fs::is_regular_file(root, ec)) {
+            files.push_back(makeBatchFile(root));
+            continue;
+        }
+        if (!fs::is_directory(root, ec)) {
+            std::cerr << "Error: cannot open input " << input << "\n";
+            return false;
+        }
+        std::vector<fs::path> found;
+        for (const auto& entry : fs::recursive_directory_iterator(root, ec)) {
+            fs::path p = entry.path();
+            if (!entry.is_regular_file()) continue;
+            if (p.extension() == ".csr") {
+                found.push_back(p);
+            } else if (p.extension() == ".txt") {
+                fs::path csr = p;
+                if (!fs::exists(csr.replace_extension(".csr"))) found.push_back(p);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        for (const fs::path& p : found) files.push_back(makeBatchFile(p));
+    }
+    for (BatchFile& f : files) {
+        std::error_code ec;
+        f.bytes = std::filesystem::file_size(f.path, ec);
+    }
+    return true;
+}
+
+/**
+ * @brief Runs runFile(fileOpts, out) on every file of opts.batchInputs
+ * and prints the CSV report. runFile is the program's single-file path:
+ * it gets opts with inputPath (and, for bin, outputPath) set to the file's
+ * and writes everything else to `out`. Returns 1 if any file failed.
+ */
+template <typename RunFile>
+int runBatch(const char* algorithm, const RunOptions& opts, RunFile runFile) {
+    namespace fs = std::filesystem;
+    std::vector<BatchFile> files;
+    if (!collectBatchFiles(opts.batchInputs, files)) return 1;
+
+    static const char* const kExtensions[] = {".txt", ".txt", ".json", ".bin"}; // by OutputFormat
+    for (BatchFile& f : files) {
+        bool wide;
+        readGraphHeader(f.path.c_str(), f.n, f.m, wide);
+        if (!opts.outputPath) continue;
+        fs::path out = fs::path(opts.outputPath) / f.category / fs::path(f.path).filename();
+        out.replace_extension(kExtensions[(int)opts.format]);
+        f.output = out.string();
+        std::error_code ec;
+        fs::create_directories(out.parent_path(), ec);
+    }
+
+    // Largest first; workers take the next file from a shared cursor
+    std::vector<size_t> order(files.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return files[a].bytes > files[b].bytes; });
+    std::atomic<size_t> next(0);
+    int jobs = opts.jobs > 0 ? opts.jobs : (int)std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::max(1, std::min(jobs, (int)files.size()));
+
+    auto worker = [&] {
+#ifdef _OPENMP
+        if (jobs > 1) omp_set_num_threads(1); // the pool already fills the cores
+#endif
+        for (size_t k; (k = next++) < order.size();) {
+            BatchFile& f = files[order[k]];
+            RunOptions fileOpts = opts;
+            fileOpts.batchInputs.clear();
+            fileOpts.inputPath = f.path.c_str();
+            fileOpts.outputPath = nullptr;
+            FILE* out = nullptr;
+            if (opts.format == OutputFormat::Binary) {
+                fileOpts.outputPath = f.output.c_str();
+                out = fopen("/dev/null", "w");
+            } else {
+                out = fopen(f.output.empty() ? "/dev/null" : f.output.c_str(), "w");
+            }
+            if (!out) {
+                std::cerr << "Error: cannot write " << f.output << "\n";
+                f.exitCode = 1;
+                continue;
+            }
+            auto start = std::chrono::high_resolution_clock::now();
+            f.exitCode = runFile(fileOpts, out);
+            fclose(out);
+            f.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < jobs; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    int status = 0;
+    printf("algorithm,category,file,n,m,time,exitcode,output\n");
+    for (const BatchFile& f : files) {
+        printf("%s,%s,%s,%lld,%lld,%.6f,%d,%s\n", algorithm, f.category.c_str(), f.file.c_str(),
+               (long long)f.n, (long long)f.m, f.seconds, f.exitCode, f.output.c_str());
+        if (f.exitCode != 0) status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,159 @@
+/*
+ * Chain decomposition BCC algorithm (p5): DFS with discovery times and
+ * low-links that skips the edge back to the parent. Each BCC is reported
+ * as its distinct edges in canonical (min, max) form, sorted. Buffers and
+ * the result live in a Workspace.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "bcc_workspace.h"
+#include "csr_graph.h"
+#include "dfs_engine.h"
+
+/**
+ * @brief Per-call DFS state of the chain decomposition algorithm, over
+ * workspace buffers.
+ */
+template <typename Id>
+struct ChainState {
+    bool summaryOnly;
+    BasicBCCResult<Id>& result;
+
+    std::vector<BasicDFSVertex<Id>>& vs; // Discovery time (<= base: unvisited), low-link, DFS parent
+    std::vector<char>& isArticulation;
+    Id base;  // clock base of this run
+    Id timer;
+    Id rootChildren = 0; // Track children for root AP check
+    std::vector<std::pair<Id, Id>>& edgeStack;
+
+    ChainState(bool summary, BasicWorkspace<Id>& ws, Id clockBase)
+        : summaryOnly(summary), result(ws.result), vs(ws.vs), isArticulation(ws.isArticulation),
+          base(clockBase), timer(clockBase), edgeStack(ws.pairStack) {
+        edgeStack.clear();
+    }
+
+    /**
+     * @brief Pops edges down to and including (u, v), or the whole stack
+     * when u == -1, as one BCC.
+     */
+    void popBCC(Id u, Id v) {
+        // The BCC is sorted and deduplicated at the end of bccEdges, where
+        // summary mode only borrows the room to count its distinct edges
+        size_t first = result.bccEdges.size();
+        while (!edgeStack.empty()) {
+            std::pair<Id, Id> edge = edgeStack.back();
+            edgeStack.pop_back();
+            // Store edges in a canonical way (min, max)
+            result.bccEdges.push_back({std::min(edge.first, edge.second), std::max(edge.first, edge.second)});
+            if (edge.first == u && edge.second == v) break; // Pop until (u,v)
+        }
+        auto begin = result.bccEdges.begin() + first;
+        std::sort(begin, result.bccEdges.end());
+        result.bccEdges.erase(std::unique(begin, result.bccEdges.end()), result.bccEdges.end());
+        result.summary.addBCC((long long)(result.bccEdges.size() - first));
+        if (summaryOnly) {
+            result.bccEdges.resize(first);
+            return;
+        }
+        result.closeBCC();
+    }
+
+    // ----- IterativeDFS visitor: finds BCCs and Articulation Points -----
+    void discover(Id u) {
+        vs[u].disc = vs[u].low = ++timer;
+    }
+
+    bool edge(Id u, Id v, Id /*slot*/) {
+        BasicDFSVertex<Id>& su = vs[u];
+        if (v == su.parent) {
+            return false; // Don't go back to the parent
+        }
+
+        BasicDFSVertex<Id>& sv = vs[v];
+        if (sv.disc > base) {
+            // This is a back-edge
+            su.low = std::min(su.low, sv.disc);
+            // Push back-edges onto the stack only if v was visited before u
+            if (sv.disc < su.disc) {
+                edgeStack.push_back({u, v});
+            }
+            return false;
+        }
+
+        // This is a tree-edge (v is a child of u)
+        if (su.parent == -1) rootChildren++;
+        sv.parent = u;
+        edgeStack.push_back({u, v});
+        return true;
+    }
+
+    void retreat(Id u, Id v, Id /*slot*/) {
+        // On callback, update low-link of u
+        BasicDFSVertex<Id>& su = vs[u];
+        su.low = std::min(su.low, vs[v].low);
+
+        // Non-root case: if low[v] >= disc[u], u is an AP
+        if (su.parent != -1 && vs[v].low >= su.disc) {
+            isArticulation[u] = 1;
+        }
+        if (vs[v].low >= su.disc) {
+            popBCC(u, v);
+        }
+    }
+
+    void finish(Id u) {
+        // Root case: if u is the root and has more than one child, it is an AP
+        if (vs[u].parent == -1 && rootChildren > 1) {
+            isArticulation[u] = 1;
+        }
+    }
+
+    void prefetch(Id w) const { DFS_PREFETCH(&vs[w]); }
+};
+
+/**
+ * @brief Finds all BCCs and articulation points of g by chain decomposition.
+ * The result lives in ws and stays valid until ws is used again.
+ */
+template <typename Id>
+const BasicBCCResult<Id>& computeBCCChain(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                          BasicWorkspace<Id>& ws) {
+    Id base = ws.beginRun(g.V, opts.prefetchDistance);
+    BasicBCCResult<Id>& result = ws.result;
+    if (!opts.summaryOnly) result.beginBCCs();
+    ChainState<Id> state(opts.summaryOnly, ws, base);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    // Run the BCC algorithm from all unvisited nodes
+    for (Id i = 0; i < g.V; ++i) {
+        if (state.vs[i].disc <= base) {
+            state.vs[i].parent = -1; // may be stale
+            state.rootChildren = 0;
+            ws.dfs.run(g, i, state);
+            // Any remaining edges on the stack form a BCC
+            if (!state.edgeStack.empty()) state.popBCC(-1, -1);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    ws.publishArticulationPoints();
+    return result;
+}
+
+/**
+ * @brief computeBCCChain on a workspace of its own.
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCCChain(const BasicCSRGraph<Id>& g, const BCCOptions& opts) {
+    BasicWorkspace<Id> ws;
+    computeBCCChain(g, opts, ws);
+    return std::move(ws.result);
+}
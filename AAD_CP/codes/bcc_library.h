@@ -0,0 +1,86 @@
+/*
+ * Single entry point to every BCC engine, for programs that embed the
+ * algorithms instead of running the p1 - p5 executables:
+ *
+ *   CSRGraph g;
+ *   loadGraph("graph.csr", g);
+ *   BCCOptions opts;
+ *   opts.algorithm = BCCAlgorithm::Chain;
+ *   BCCResult r = computeBCC(g, opts);
+ *
+ * The engines keep no global state: each call owns its working memory, so
+ * computeBCC can be called repeatedly and from several threads at once
+ * (on the same or different graphs; the graph is only read).
+ *
+ * Graphs beyond 32-bit ids load into a CSRGraph64 (see needsWideIds() in
+ * csr_graph.h); computeBCC on it returns a BCCResult64.
+ *
+ * Callers running many graphs back to back can pass a Workspace
+ * (bcc_workspace.h) instead, so the engines reuse its buffers:
+ *
+ *   Workspace ws;
+ *   const BCCResult& r = computeBCC(g, opts, ws); // valid until ws is reused
+ */
+
+#pragma once
+
+#include "bcc_chain.h"
+#include "bcc_lowlink_sweep.h"
+#include "bcc_naive.h"
+#include "bcc_result.h"
+#include "bcc_slota_madduri.h"
+#include "bcc_tarjan.h"
+#include "bcc_tarjan_vishkin.h"
+#include "bcc_workspace.h"
+#include "csr_graph.h"
+#include "vertex_order.h"
+
+/**
+ * @brief Runs the engine selected by opts.algorithm on g, renumbering the
+ * vertices first when opts.order asks for it (the result is always in g's
+ * vertex ids).
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCC(const BasicCSRGraph<Id>& g, const BCCOptions& opts) {
+    BCCOptions engineOpts = opts;
+    engineOpts.order = VertexOrder::None;
+    bool sweep = opts.edgeStackFree && (opts.algorithm == BCCAlgorithm::Tarjan ||
+                                        opts.algorithm == BCCAlgorithm::SlotaMadduri ||
+                                        opts.algorithm == BCCAlgorithm::Chain);
+    bool canonicalEdges = sweep || opts.algorithm != BCCAlgorithm::SlotaMadduri;
+    return computeReordered(g, opts.order, canonicalEdges, [&](const BasicCSRGraph<Id>& graph) {
+        if (sweep) return computeBCCLowLinkSweep(graph, engineOpts);
+        switch (opts.algorithm) {
+            case BCCAlgorithm::TarjanVishkin: return computeBCCTarjanVishkin(graph, engineOpts);
+            case BCCAlgorithm::SlotaMadduri:  return computeBCCSlotaMadduri(graph, engineOpts);
+            case BCCAlgorithm::Naive:         return computeBCCNaive(graph, engineOpts);
+            case BCCAlgorithm::Chain:         return computeBCCChain(graph, engineOpts);
+            case BCCAlgorithm::Tarjan:
+            default:                          return computeBCCTarjan(graph, engineOpts);
+        }
+    });
+}
+
+/**
+ * @brief computeBCC reusing ws. Tarjan, Slota-Madduri, chain and the sweep
+ * run in the workspace; the other engines, and every renumbered run, have
+ * their result moved into it.
+ */
+template <typename Id>
+const BasicBCCResult<Id>& computeBCC(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                     BasicWorkspace<Id>& ws) {
+    if (opts.order != VertexOrder::None) {
+        ws.result = computeBCC(g, opts);
+        return ws.result;
+    }
+    bool sweep = opts.edgeStackFree && (opts.algorithm == BCCAlgorithm::Tarjan ||
+                                        opts.algorithm == BCCAlgorithm::SlotaMadduri ||
+                                        opts.algorithm == BCCAlgorithm::Chain);
+    if (sweep) return computeBCCLowLinkSweep(g, opts, ws);
+    switch (opts.algorithm) {
+        case BCCAlgorithm::Tarjan:        return computeBCCTarjan(g, opts, ws);
+        case BCCAlgorithm::SlotaMadduri:  return computeBCCSlotaMadduri(g, opts, ws);
+        case BCCAlgorithm::Chain:         return computeBCCChain(g, opts, ws);
+        default:                          ws.result = computeBCC(g, opts); return ws.result;
+    }
+}
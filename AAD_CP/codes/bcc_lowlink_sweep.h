@@ -0,0 +1,160 @@
+/*
+ * Edge-stack-free BCC labelling (--no-edge-stack in p1, p3 and p5).
+ *
+ * The stack engines push and pop every edge, and the stack can hold O(E)
+ * ids at once. This engine runs one DFS that only records disc, low and
+ * the tree parent of each vertex, then labels the edges with two
+ * sequential sweeps:
+ *   1. Vertices in preorder: the tree edge into v starts a new BCC when
+ *      low[v] >= disc[parent(v)], otherwise it joins its parent's tree
+ *      edge's BCC. Preorder handles a parent before its children.
+ *   2. CSR slots: every non-loop edge joins a BCC at its deeper endpoint
+ *      (larger disc). In an undirected DFS every non-tree edge joins a
+ *      vertex to one of its ancestors, so it gets that vertex's
+ *      tree-edge label.
+ * Auxiliary memory is O(V) plus the label array, all of it in a Workspace.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "bcc_result.h"
+#include "bcc_workspace.h"
+#include "csr_graph.h"
+#include "dfs_engine.h"
+
+/**
+ * @brief DFS visitor computing only disc, low and the tree parent.
+ */
+template <typename Id>
+struct LowLinkState {
+    const Id* edgeIds; // edge id of every CSR slot
+    std::vector<BasicDFSVertex<Id>>& vs;
+    std::vector<Id>& preorder; // vertices by discovery time
+    Id base;          // records with disc <= base are unvisited
+    Id discoveryTime;
+
+    LowLinkState(const BasicCSRGraph<Id>& g, const Id* ids, BasicWorkspace<Id>& ws, Id clockBase)
+        : edgeIds(ids), vs(ws.vs), preorder(ws.preorder), base(clockBase), discoveryTime(clockBase) {
+        preorder.clear();
+        reserveGeometric(preorder, (size_t)g.V);
+    }
+
+    void discover(Id u) {
+        vs[u].disc = vs[u].low = ++discoveryTime;
+        preorder.push_back(u);
+    }
+
+    bool edge(Id u, Id v, Id slot) {
+        Id e = edgeIds[slot];
+        BasicDFSVertex<Id>& su = vs[u];
+        BasicDFSVertex<Id>& sv = vs[v];
+        if (sv.disc <= base) {
+            sv.parent = u;
+            sv.parentEdge = e;
+            return true;
+        }
+        if (e != su.parentEdge) su.low = std::min(su.low, sv.disc);
+        return false;
+    }
+
+    void retreat(Id u, Id v, Id /*slot*/) {
+        vs[u].low = std::min(vs[u].low, vs[v].low);
+    }
+
+    void finish(Id) {}
+
+    void prefetch(Id w) const { DFS_PREFETCH(&vs[w]); }
+};
+
+/**
+ * @brief Finds all BCCs and articulation points of g without an edge
+ * stack. BCCs are numbered in preorder of their first tree edge
+ * (self-loops keep label -1). The flat lists hold each BCC's canonical
+ * edges, sorted, as in computeBCCTarjan. The result lives in ws and stays
+ * valid until ws is used again.
+ */
+template <typename Id>
+const BasicBCCResult<Id>& computeBCCLowLinkSweep(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                                 BasicWorkspace<Id>& ws) {
+    Id base = ws.beginRun(g.V, opts.prefetchDistance);
+    BasicBCCResult<Id>& result = ws.result;
+    std::vector<Id> recoveredIds;
+    const Id* edgeIds = g.edgeIds;
+    if (!edgeIds) {
+        recoveredIds = csrEdgeIds(g);
+        edgeIds = recoveredIds.data();
+    }
+    LowLinkState<Id> state(g, edgeIds, ws, base);
+    std::vector<char>& isArticulation = ws.isArticulation;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (Id i = 0; i < g.V; ++i) {
+        if (state.vs[i].disc <= base) {
+            state.vs[i].parent = state.vs[i].parentEdge = -1; // may be stale
+            ws.dfs.run(g, i, state);
+        }
+    }
+
+    // Sweep 1: label every vertex's tree edge, in preorder. Components are
+    // contiguous in preorder, so only one root is open at a time.
+    const std::vector<BasicDFSVertex<Id>>& vs = state.vs;
+    std::vector<Id>& vertexLabel = ws.vertexLabel; // set before it is read
+    reserveGeometric(vertexLabel, (size_t)g.V);
+    vertexLabel.resize(g.V);
+    Id numBCCs = 0;
+    Id root = -1, rootChildren = 0;
+    for (Id v : state.preorder) {
+        Id p = vs[v].parent;
+        if (p == -1) {
+            if (rootChildren > 1) isArticulation[root] = 1;
+            root = v;
+            rootChildren = 0;
+            continue;
+        }
+        if (vs[v].low >= vs[p].disc) {
+            vertexLabel[v] = numBCCs++;
+            if (p != root) isArticulation[p] = 1;
+            else rootChildren++;
+        } else {
+            vertexLabel[v] = vertexLabel[p];
+        }
+    }
+    if (rootChildren > 1) isArticulation[root] = 1;
+
+    // Sweep 2: every edge takes the label of its deeper endpoint
+    result.edgeToBCC.assign(g.E, -1);
+    for (Id u = 0; u < g.V; ++u) {
+        Id du = vs[u].disc;
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id v = g.neighbors[i];
+            if (vs[v].disc >= du) continue; // self-loop, or seen from v
+            result.edgeToBCC[edgeIds[i]] = vertexLabel[u];
+        }
+    }
+    for (Id count : distinctEdgesPerLabel(g, edgeIds, result.edgeToBCC, numBCCs)) {
+        result.summary.addBCC(count);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    if (!opts.summaryOnly) {
+        csrEdgeList(g, ws.endpoints);
+        groupEdgesByLabel(result, ws.endpoints);
+    }
+    ws.publishArticulationPoints();
+    return result;
+}
+
+/**
+ * @brief computeBCCLowLinkSweep on a workspace of its own.
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCCLowLinkSweep(const BasicCSRGraph<Id>& g, const BCCOptions& opts) {
+    BasicWorkspace<Id> ws;
+    computeBCCLowLinkSweep(g, opts, ws);
+    return std::move(ws.result);
+}
@@ -0,0 +1,203 @@
+/*
+ * Options and result types of the BCC library (bcc_library.h).
+ *
+ * Every engine is a plain function template `BasicBCCResult<Id>
+ * computeBCCxxx(const BasicCSRGraph<Id>&, const BCCOptions&)` that keeps all
+ * of its state on the stack of the call, so it can run any number of times,
+ * on different graphs, from several threads at once. Id is int32_t
+ * (BCCResult) or, for graphs too large for it, int64_t (BCCResult64).
+ * The DFS engines also take a Workspace (bcc_workspace.h) that keeps their
+ * buffers and the result between calls.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bcc_summary.h"
+#include "csr_graph.h"
+
+enum class BCCAlgorithm { Tarjan, TarjanVishkin, SlotaMadduri, Naive, Chain };
+
+// Vertex renumbering applied before the engine runs (vertex_order.h)
+enum class VertexOrder { None, BFS, RCM, Degree, DFS };
+
+struct BCCOptions {
+    BCCAlgorithm algorithm = BCCAlgorithm::Tarjan; // engine picked by computeBCC()
+    bool summaryOnly = false; // fill only `summary`, keep no per-BCC edge lists
+    VertexOrder order = VertexOrder::None; // renumbering done by computeBCC()
+    int prefetchDistance = -1; // DFS look-ahead in neighbor slots (dfs_engine.h); -1: default, 0: off
+    bool edgeStackFree = false; // Tarjan, Slota-Madduri, Chain: run the low/disc sweep engine instead
+};
+
+/**
+ * @brief Contiguous run of (u, v) edges, usable in range-for.
+ */
+template <typename Id>
+struct BasicEdgeSpan {
+    const std::pair<Id, Id>* first;
+    const std::pair<Id, Id>* last;
+    const std::pair<Id, Id>* begin() const { return first; }
+    const std::pair<Id, Id>* end() const { return last; }
+    Id size() const { return (Id)(last - first); }
+};
+using EdgeSpan = BasicEdgeSpan<int32_t>;
+
+template <typename Id>
+struct BasicBCCResult {
+    bool hasBCCs = true; // false: the engine finds articulation points only (naive)
+
+    // Edges of every BCC in the engine's report order, stored flat: BCC i is
+    // bccEdges[bccOffsets[i] .. bccOffsets[i + 1]). Both stay empty with
+    // summaryOnly.
+    std::vector<Id> bccOffsets;
+    std::vector<std::pair<Id, Id>> bccEdges;
+
+    // BCC label per edge id (-1: self-loop), filled by engines that label
+    // edges directly (Tarjan, Tarjan-Vishkin); empty otherwise. Labels run
+    // 0 .. summary.bccs - 1.
+    std::vector<Id> edgeToBCC;
+
+    // Articulation points: bit v of articulationBits[v / 64], and ascending
+    std::vector<uint64_t> articulationBits;
+    std::vector<Id> articulationPoints;
+
+    BCCSummary summary;        // filled in every mode
+    double seconds = 0;        // time spent in the algorithm proper
+    double reorderSeconds = 0; // time spent renumbering vertices first (0: not done)
+
+    Id numBCCs() const { return bccOffsets.empty() ? 0 : (Id)bccOffsets.size() - 1; }
+    BasicEdgeSpan<Id> bcc(Id i) const {
+        return {bccEdges.data() + bccOffsets[i], bccEdges.data() + bccOffsets[i + 1]};
+    }
+    bool isArticulationPoint(Id v) const { return (articulationBits[v >> 6] >> (v & 63)) & 1; }
+
+    /**
+     * @brief Empties the result for another run, keeping the capacity of
+     * every vector.
+     */
+    void clear() {
+        hasBCCs = true;
+        bccOffsets.clear();
+        bccEdges.clear();
+        edgeToBCC.clear();
+        articulationBits.clear();
+        articulationPoints.clear();
+        summary = BCCSummary();
+        seconds = reorderSeconds = 0;
+    }
+
+    // Engines append a BCC's edges to bccEdges, then close it
+    void beginBCCs() { bccOffsets.assign(1, 0); bccEdges.clear(); }
+    void closeBCC() { bccOffsets.push_back((Id)bccEdges.size()); }
+
+    /**
+     * @brief Fills both articulation point forms from a per-vertex flag.
+     */
+    void setArticulationPoints(const std::vector<char>& isArticulation) {
+        Id V = (Id)isArticulation.size();
+        articulationBits.assign(((size_t)V + 63) / 64, 0);
+        articulationPoints.clear();
+        for (Id v = 0; v < V; ++v) {
+            if (!isArticulation[v]) continue;
+            articulationBits[v >> 6] |= 1ull << (v & 63);
+            articulationPoints.push_back(v);
+        }
+    }
+};
+using BCCResult = BasicBCCResult<int32_t>;
+using BCCResult64 = BasicBCCResult<int64_t>;
+
+/**
+ * @brief Builds the flat BCC lists of r from r.edgeToBCC: edge ids are
+ * grouped by label with a counting sort, and each BCC is stored as its
+ * canonical (min, max) edges, sorted, parallel copies once. `endpoints`
+ * gives the two ends of every edge id.
+ */
+template <typename Id>
+void groupEdgesByLabel(BasicBCCResult<Id>& r, const std::vector<std::pair<Id, Id>>& endpoints) {
+    Id numBCCs = (Id)r.summary.bccs;
+    std::vector<Id> start((size_t)numBCCs + 1, 0);
+    for (Id label : r.edgeToBCC) {
+        if (label != -1) start[label + 1]++;
+    }
+    for (Id i = 0; i < numBCCs; ++i) start[i + 1] += start[i];
+    std::vector<Id> fill(start.begin(), start.end() - 1);
+    r.bccEdges.resize(start[numBCCs]);
+    for (size_t e = 0; e < r.edgeToBCC.size(); ++e) {
+        Id label = r.edgeToBCC[e];
+        if (label == -1) continue;
+        Id u = endpoints[e].first, v = endpoints[e].second;
+        r.bccEdges[fill[label]++] = {std::min(u, v), std::max(u, v)};
+    }
+
+    // Sort each BCC and compact the duplicates out in place
+    r.bccOffsets.assign(1, 0);
+    size_t out = 0;
+    for (Id i = 0; i < numBCCs; ++i) {
+        auto first = r.bccEdges.begin() + start[i], last = r.bccEdges.begin() + start[i + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        for (auto it = first; it != last; ++it) r.bccEdges[out++] = *it;
+        r.bccOffsets.push_back((Id)out);
+    }
+    r.bccEdges.resize(out);
+}
+
+/**
+ * @brief Distinct edges carrying each label 0 .. numBCCs - 1: parallel
+ * copies of an edge count once, as in the flat BCC lists, so a doubled
+ * edge makes a one-edge BCC (a bridge) in every output. One pass over the
+ * CSR slots, each edge seen from its smaller endpoint; `edgeIds` gives
+ * the edge id of every slot.
+ */
+template <typename Id>
+std::vector<Id> distinctEdgesPerLabel(const BasicCSRGraph<Id>& g, const Id* edgeIds,
+                                      const std::vector<Id>& edgeToBCC, Id numBCCs) {
+    std::vector<Id> counts(numBCCs, 0);
+    std::vector<Id> seenFrom(g.V, -1); // last u whose span listed v
+    for (Id u = 0; u < g.V; ++u) {
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id v = g.neighbors[i];
+            if (v <= u || seenFrom[v] == u) continue; // seen from v, or a parallel copy
+            seenFrom[v] = u;
+            Id label = edgeToBCC[edgeIds[i]];
+            if (label != -1) counts[label]++;
+        }
+    }
+    return counts;
+}
+
+/**
+ * @brief Derives the articulation points of g from a per-edge BCC
+ * labelling, for any engine that produces one: a vertex is an articulation
+ * point iff its edges carry more than one label. One pass over the CSR
+ * slots on all OpenMP threads, leaving each vertex at its second label.
+ * `edgeIds` gives the edge id of every slot (g.edgeIds or csrEdgeIds(g));
+ * unlabelled edges (-1) are ignored. Sets one flag per vertex.
+ */
+template <typename Id>
+void articulationPointsFromLabels(const BasicCSRGraph<Id>& g, const Id* edgeIds,
+                                  const std::vector<Id>& edgeToBCC, std::vector<char>& isArticulation) {
+    isArticulation.resize(g.V);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1024) if(g.V >= 4096)
+#endif
+    for (Id u = 0; u < g.V; ++u) {
+        Id first = -1;
+        char cut = 0;
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id label = edgeToBCC[edgeIds[i]];
+            if (label == -1 || label == first) continue;
+            if (first != -1) {
+                cut = 1;
+                break;
+            }
+            first = label;
+        }
+        isArticulation[u] = cut;
+    }
+}
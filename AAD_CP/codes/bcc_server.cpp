@@ -0,0 +1,428 @@
+/*
+ * Resident BCC query server. Loads one graph, runs a BCC engine once and
+ * answers articulation-point, bridge and same-BCC queries from memory over
+ * a Unix domain socket, so repeated questions about the same graph do not
+ * pay for loading and the DFS again.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o bcc_server bcc_server.cpp
+ * Usage: ./bcc_server graph.txt|graph.csr [--socket=/tmp/bcc.sock]
+ *                     [--algorithm=tarjan|tarjan-vishkin|slota-madduri|chain]
+ *
+ * Protocol: one request per line, exactly one response line per request;
+ * requests may be pipelined.
+ *   AP v         1 if v is an articulation point, else 0
+ *   BRIDGE u v   1 if an edge (u, v) exists and is a bridge, else 0
+ *   SAME u v     1 if u and v lie in a common BCC, else 0 (so SAME u u is
+ *                0 for a vertex with no edges)
+ *   INFO         graph size, BCC counts and load/compute times
+ *   STATS        per-command request count and service latency
+ *   QUIT         closes this connection
+ *   SHUTDOWN     stops the server
+ * Errors are answered with "ERR <reason>"; request lines over 4 KiB close
+ * the connection. Graphs with 64-bit ids (see needsWideIds()) are served too.
+ *
+ * Example: printf 'AP 17\nSAME 3 9\nSTATS\n' | socat - UNIX-CONNECT:/tmp/bcc.sock
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <mutex>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "bcc_library.h"
+#include "csr_graph.h"
+#include "result_output.h"
+
+using namespace std;
+
+// ===== Query index =====
+
+/**
+ * @brief Everything the queries need, built once after the engine ran.
+ * The per-BCC edge lists are dropped; only labels and flags are kept.
+ * Ids and labels are Id wide, like the graph they were computed on.
+ */
+template <typename Id>
+struct BasicQueryIndex {
+    BasicCSRGraph<Id> graph;
+    vector<Id> edgeToBCC;        // BCC label per edge id (-1: self-loop)
+    vector<Id> edgesPerBCC;      // distinct edges of every BCC
+    vector<char> isArticulation;
+    vector<Id> labelOffsets;     // BCC labels touching vertex u are
+    vector<Id> labels;           // labels[labelOffsets[u] .. labelOffsets[u+1])
+    Id numBCCs = 0, numArticulationPoints = 0, numBridges = 0;
+    double loadSeconds = 0, computeSeconds = 0;
+
+    bool build(const char* path, BCCAlgorithm algorithm) {
+        auto start = chrono::high_resolution_clock::now();
+        if (!loadGraph(path, graph)) return false;
+        if (!graph.edgeIds) {
+            // Queries look edges up by id; give id-less binary files ids
+            BasicEdgeList<Id> list;
+            list.V = graph.V;
+            list.edges = csrEdgeList(graph);
+            list.E = (Id)list.edges.size();
+            graph = buildCSR(list);
+        }
+        loadSeconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+        BCCOptions opts;
+        opts.algorithm = algorithm;
+        BasicResultRecord<Id> record;
+        {
+            BasicBCCResult<Id> result = computeBCC(graph, opts);
+            computeSeconds = result.seconds;
+            record = makeResultRecord("", graph, result, loadSeconds);
+        }
+        edgeToBCC = std::move(record.edgeToBCC);
+        numBCCs = record.numBCCs;
+        numArticulationPoints = record.numArticulationPoints;
+
+        isArticulation.assign(graph.V, 0);
+        for (Id v = 0; v < graph.V; ++v) {
+            isArticulation[v] = (record.articulationBits[v >> 6] >> (v & 63)) & 1;
+        }
+        edgesPerBCC = distinctEdgesPerLabel(graph, graph.edgeIds, edgeToBCC, numBCCs);
+        numBridges = (Id)count(edgesPerBCC.begin(), edgesPerBCC.end(), 1);
+
+        // Distinct BCC labels around every vertex, sorted for intersection
+        labelOffsets.assign((size_t)graph.V + 1, 0);
+        labels.clear();
+        for (Id u = 0; u < graph.V; ++u) {
+            size_t first = labels.size();
+            for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i) {
+                Id label = edgeToBCC[graph.edgeIds[i]];
+                if (label >= 0) labels.push_back(label);
+            }
+            sort(labels.begin() + first, labels.end());
+            labels.erase(unique(labels.begin() + first, labels.end()), labels.end());
+            labelOffsets[u + 1] = (Id)labels.size();
+        }
+        return true;
+    }
+
+    bool validVertex(long long v) const { return v >= 0 && v < (long long)graph.V; }
+
+    bool isBridge(Id u, Id v) const {
+        // Scan the shorter adjacency list for the edge
+        if (graph.degree(u) > graph.degree(v)) swap(u, v);
+        for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i) {
+            if (graph.neighbors[i] != v) continue;
+            Id label = edgeToBCC[graph.edgeIds[i]];
+            return label >= 0 && edgesPerBCC[label] == 1;
+        }
+        return false;
+    }
+
+    bool sameBCC(Id u, Id v) const {
+        if (u == v) return labelOffsets[u + 1] > labelOffsets[u]; // isolated: in no BCC
+        const Id* a = labels.data() + labelOffsets[u];
+        const Id* aEnd = labels.data() + labelOffsets[u + 1];
+        const Id* b = labels.data() + labelOffsets[v];
+        const Id* bEnd = labels.data() + labelOffsets[v + 1];
+        while (a != aEnd && b != bEnd) {
+            if (*a == *b) return true;
+            if (*a < *b) ++a;
+            else ++b;
+        }
+        return false;
+    }
+};
+
+// ===== Latency metrics =====
+
+/**
+ * @brief Request count and service-time histogram of one command
+ * (log2 buckets of nanoseconds).
+ */
+struct LatencyStats {
+    long long count = 0, totalNs = 0, maxNs = 0;
+    long long buckets[64] = {};
+
+    void add(long long ns) {
+        count++;
+        totalNs += ns;
+        maxNs = max(maxNs, ns);
+        buckets[ns > 0 ? 63 - __builtin_clzll((unsigned long long)ns) : 0]++;
+    }
+
+    // Upper bound of the bucket holding the p-th fraction of requests
+    long long percentileNs(double p) const {
+        long long target = (long long)(p * count), seen = 0;
+        for (int k = 0; k < 64; ++k) {
+            seen += buckets[k];
+            if (seen > target) return min(maxNs, (2ll << k) - 1);
+        }
+        return maxNs;
+    }
+};
+
+enum Command { CMD_AP, CMD_BRIDGE, CMD_SAME, CMD_INFO, CMD_STATS, CMD_OTHER, NUM_COMMANDS };
+const char* commandNames[NUM_COMMANDS] = {"ap", "bridge", "same", "info", "stats", "other"};
+
+LatencyStats stats[NUM_COMMANDS];
+mutex statsMutex;
+
+int listenFd = -1;
+volatile sig_atomic_t stopRequested = 0;
+
+// Longest request line accepted, and how many response bytes a client may
+// have buffered before they are sent, even mid-batch
+const size_t MAX_LINE_BYTES = 4096;
+const size_t MAX_PENDING_RESPONSE = 1 << 16;
+
+string formatStats() {
+    lock_guard<mutex> lock(statsMutex);
+    string out = "OK";
+    char buf[160];
+    for (int c = 0; c < NUM_COMMANDS; ++c) {
+        const LatencyStats& s = stats[c];
+        if (s.count == 0) continue;
+        snprintf(buf, sizeof(buf), " %s: n=%lld mean=%.2fus p50<=%.2fus p99<=%.2fus max=%.2fus;",
+                 commandNames[c], s.count, s.totalNs / 1e3 / s.count,
+                 s.percentileNs(0.5) / 1e3, s.percentileNs(0.99) / 1e3, s.maxNs / 1e3);
+        out += buf;
+    }
+    return out;
+}
+
+/**
+ * @brief Stops the accept loop in main (also used from signal handlers).
+ */
+void requestStop() {
+    stopRequested = 1;
+    shutdown(listenFd, SHUT_RDWR); // wakes up accept()
+}
+
+// ===== Request handling =====
+
+/**
+ * @brief Answers one request line. Returns false when the connection
+ * should be closed after the response; stopServer is set by SHUTDOWN,
+ * which the caller acts on once the response has been sent.
+ */
+template <typename Id>
+bool handleRequest(const BasicQueryIndex<Id>& index, const char* line, string& response, bool& stopServer) {
+    auto start = chrono::steady_clock::now();
+    char word[16] = {0};
+    long long a = -1, b = -1;
+    int fields = sscanf(line, "%15s %lld %lld", word, &a, &b);
+    for (char* p = word; *p; ++p) *p = (char)toupper((unsigned char)*p);
+
+    Command cmd = CMD_OTHER;
+    bool keepOpen = true;
+    char buf[256];
+    if (fields < 1) {
+        response += "ERR empty request\n";
+    } else if (strcmp(word, "AP") == 0) {
+        cmd = CMD_AP;
+        if (fields < 2 || !index.validVertex(a)) response += "ERR usage: AP v (0 <= v < V)\n";
+        else response += index.isArticulation[a] ? "1\n" : "0\n";
+    } else if (strcmp(word, "BRIDGE") == 0 || strcmp(word, "SAME") == 0) {
+        cmd = word[0] == 'B' ? CMD_BRIDGE : CMD_SAME;
+        if (fields < 3 || !index.validVertex(a) || !index.validVertex(b)) {
+            response += "ERR usage: ";
+            response += word;
+            response += " u v (0 <= u, v < V)\n";
+        } else {
+            bool yes = cmd == CMD_BRIDGE ? index.isBridge((Id)a, (Id)b) : index.sameBCC((Id)a, (Id)b);
+            response += yes ? "1\n" : "0\n";
+        }
+    } else if (strcmp(word, "INFO") == 0) {
+        cmd = CMD_INFO;
+        snprintf(buf, sizeof(buf),
+                 "OK vertices=%lld edges=%lld bccs=%lld articulation_points=%lld bridges=%lld"
+                 " load_ms=%.3f compute_ms=%.3f\n",
+                 (long long)index.graph.V, (long long)index.graph.E, (long long)index.numBCCs,
+                 (long long)index.numArticulationPoints, (long long)index.numBridges,
+                 index.loadSeconds * 1e3, index.computeSeconds * 1e3);
+        response += buf;
+    } else if (strcmp(word, "STATS") == 0) {
+        cmd = CMD_STATS;
+        response += formatStats() + "\n";
+    } else if (strcmp(word, "QUIT") == 0) {
+        response += "OK bye\n";
+        keepOpen = false;
+    } else if (strcmp(word, "SHUTDOWN") == 0) {
+        response += "OK shutting down\n";
+        stopServer = true;
+        keepOpen = false;
+    } else {
+        response += "ERR unknown command\n";
+    }
+
+    long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    lock_guard<mutex> lock(statsMutex);
+    stats[cmd].add(ns);
+    return keepOpen;
+}
+
+/**
+ * @brief Writes all of response to fd and clears it. Returns false if
+ * the client went away.
+ */
+bool sendAll(int fd, string& response) {
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t w = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (w <= 0) break;
+        sent += (size_t)w;
+    }
+    bool ok = sent == response.size();
+    response.clear();
+    return ok;
+}
+
+/**
+ * @brief Serves one client: answers every complete line in each read and
+ * sends the responses back in one write (or one per MAX_PENDING_RESPONSE
+ * bytes, so a client that does not read blocks instead of growing the
+ * buffer). A SHUTDOWN stops the server only after its ack is sent.
+ */
+template <typename Id>
+void serveClient(const BasicQueryIndex<Id>& index, int fd) {
+    string pending, response;
+    char buf[1 << 16];
+    bool open = true, stopServer = false;
+    while (open) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        pending.append(buf, (size_t)n);
+
+        size_t begin = 0, end;
+        while (open && (end = pending.find('\n', begin)) != string::npos) {
+            pending[end] = '\0';
+            if (end > begin && pending[end - 1] == '\r') pending[end - 1] = '\0';
+            open = handleRequest(index, pending.c_str() + begin, response, stopServer);
+            begin = end + 1;
+            if (response.size() >= MAX_PENDING_RESPONSE && !sendAll(fd, response)) open = false;
+        }
+        pending.erase(0, begin);
+        if (open && pending.size() > MAX_LINE_BYTES) {
+            response += "ERR request line too long\n";
+            open = false;
+        }
+        if (!sendAll(fd, response)) open = false;
+    }
+    close(fd);
+    if (stopServer) requestStop();
+}
+
+void onSignal(int) {
+    requestStop();
+}
+
+/**
+ * @brief Loads the graph with Id-wide ids, then answers clients on addr
+ * until SHUTDOWN or a signal.
+ */
+template <typename Id>
+int serve(const char* graphPath, BCCAlgorithm algorithm, const string& socketPath, const sockaddr_un& addr) {
+    // Outlives main's return, as detached client threads may still read it
+    static BasicQueryIndex<Id> index;
+    if (!index.build(graphPath, algorithm)) return 1;
+    cerr << "Loaded " << graphPath << ": " << index.graph.V << " vertices, " << index.graph.E
+         << " edges, " << index.numBCCs << " BCCs, " << index.numArticulationPoints
+         << " articulation points (load " << index.loadSeconds << " s, compute "
+         << index.computeSeconds << " s)\n";
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        cerr << "Error: cannot create socket\n";
+        return 1;
+    }
+    // Replace a stale socket from an earlier run, but never anything else
+    struct stat st;
+    if (lstat(socketPath.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            cerr << "Error: " << socketPath << " exists and is not a socket\n";
+            close(listenFd);
+            return 1;
+        }
+        unlink(socketPath.c_str());
+    }
+    if (bind(listenFd, (const sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 64) != 0) {
+        cerr << "Error: cannot listen on " << socketPath << ": " << strerror(errno) << "\n";
+        close(listenFd);
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    cerr << "Listening on " << socketPath << "\n";
+
+    while (!stopRequested) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        thread(serveClient<Id>, cref(index), fd).detach();
+    }
+
+    close(listenFd);
+    unlink(socketPath.c_str());
+    cerr << "Stopped. " << formatStats() << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* graphPath = nullptr;
+    string socketPath = "/tmp/bcc.sock";
+    BCCAlgorithm algorithm = BCCAlgorithm::Tarjan;
+    const char* usage = " graph.txt|graph.csr [--socket=path]"
+                        " [--algorithm=tarjan|tarjan-vishkin|slota-madduri|chain]\n";
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--socket=", 0) == 0) {
+            socketPath = arg.substr(9);
+        } else if (arg.rfind("--algorithm=", 0) == 0) {
+            string name = arg.substr(12);
+            if (name == "tarjan") algorithm = BCCAlgorithm::Tarjan;
+            else if (name == "tarjan-vishkin") algorithm = BCCAlgorithm::TarjanVishkin;
+            else if (name == "slota-madduri") algorithm = BCCAlgorithm::SlotaMadduri;
+            else if (name == "chain") algorithm = BCCAlgorithm::Chain;
+            else {
+                cerr << "Usage: " << argv[0] << usage;
+                return 1;
+            }
+        } else if (!graphPath) {
+            graphPath = argv[i];
+        } else {
+            cerr << "Usage: " << argv[0] << usage;
+            return 1;
+        }
+    }
+    if (!graphPath) {
+        cerr << "Usage: " << argv[0] << usage;
+        return 1;
+    }
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        cerr << "Error: socket path too long: " << socketPath << "\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, socketPath.c_str());
+
+    // 64-bit ids only when the input's header asks for them, as in p1 - p5
+    bool wide;
+    if (!needsWideIds(graphPath, wide)) return 1;
+    return wide ? serve<int64_t>(graphPath, algorithm, socketPath, addr)
+                : serve<int32_t>(graphPath, algorithm, socketPath, addr);
+}
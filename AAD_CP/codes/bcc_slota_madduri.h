@@ -0,0 +1,243 @@
+/*
+ * Slota-Madduri parallel BCC algorithm (p3): the connected components are
+ * found first and each one is run through Tarjan's DFS on its own OpenMP
+ * thread.
+ *
+ * Each thread appends the output of the components it takes to its own
+ * buffers and records where each component's part starts; the parts are
+ * joined in component order afterwards, so no lock is needed and the
+ * output is the same for every thread count. Without -fopenmp the
+ * components are simply processed one after another.
+ *
+ * Components are vertex-disjoint, so all threads share the workspace's
+ * per-vertex DFS records. The component lists and the per-thread buffers
+ * (edge stack, DFS frames, BCC output) live in the workspace too, so
+ * back-to-back runs reuse them instead of allocating per component.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "bcc_workspace.h"
+#include "csr_graph.h"
+#include "dfs_engine.h"
+#include "parallel_utils.h"
+
+// Per-thread DFS variables, reused for every component the thread takes;
+// the IterativeDFS visitor
+template <typename Id>
+struct ComponentData {
+    std::vector<std::pair<Id, Id>>& edgeStack;
+    std::vector<BasicDFSVertex<Id>>& vs; // shared; disc <= base: not visited yet
+    Id base;
+    Id discoveryTime;
+    Id rootChildren;
+    bool summaryOnly;
+    std::vector<Id>& articulationPoints;
+    std::vector<std::pair<Id, Id>>& bccEdges; // this thread's BCCs, flat:
+    std::vector<Id>& bccEnds;                 // BCC k ends at bccEnds[k]
+    std::vector<std::pair<Id, Id>>& distinctEdges; // canonical edges of the BCC being popped
+    BCCSummary summary;
+
+    ComponentData(BasicComponentBuffers<Id>& buffers, std::vector<BasicDFSVertex<Id>>& records,
+                  Id clockBase, bool summary)
+        : edgeStack(buffers.edgeStack), vs(records), base(clockBase), discoveryTime(clockBase),
+          rootChildren(0), summaryOnly(summary), articulationPoints(buffers.articulationPoints),
+          bccEdges(buffers.bccEdges), bccEnds(buffers.bccEnds),
+          distinctEdges(buffers.distinctEdges) {
+        edgeStack.clear();
+        articulationPoints.clear();
+        bccEdges.clear();
+        bccEnds.clear();
+    }
+
+    /**
+     * @brief Pops edges down to and including (u, v), or the whole stack
+     * when u == -1, as one BCC. The BCC is output as popped but counted by
+     * its distinct edges, like the flat lists of the other engines.
+     */
+    void popBCC(Id u, Id v) {
+        distinctEdges.clear();
+        while (!edgeStack.empty()) {
+            std::pair<Id, Id> edge = edgeStack.back();
+            edgeStack.pop_back();
+            if (!summaryOnly) bccEdges.push_back(edge);
+            distinctEdges.push_back({std::min(edge.first, edge.second), std::max(edge.first, edge.second)});
+            if (edge.first == u && edge.second == v) break;
+        }
+        std::sort(distinctEdges.begin(), distinctEdges.end());
+        summary.addBCC(std::unique(distinctEdges.begin(), distinctEdges.end()) - distinctEdges.begin());
+        if (!summaryOnly) bccEnds.push_back((Id)bccEdges.size());
+    }
+
+    // ----- DFS for finding BCCs (Tarjan's algorithm) -----
+    void discover(Id u) {
+        vs[u].disc = vs[u].low = ++discoveryTime;
+    }
+
+    bool edge(Id u, Id v, Id /*slot*/) {
+        BasicDFSVertex<Id>& su = vs[u];
+        BasicDFSVertex<Id>& sv = vs[v];
+        // Push edge to stack
+        if (sv.disc <= base) {
+            edgeStack.push_back({u, v});
+            if (su.parent == -1) rootChildren++;
+            sv.parent = u;
+            return true;
+        }
+        if (v != su.parent) {
+            if (sv.disc < su.disc) edgeStack.push_back({u, v});
+            su.low = std::min(su.low, sv.disc);
+        }
+        return false;
+    }
+
+    void retreat(Id u, Id v, Id /*slot*/) {
+        BasicDFSVertex<Id>& su = vs[u];
+        su.low = std::min(su.low, vs[v].low);
+
+        // Check if u is articulation point and extract BCC
+        if (vs[v].low >= su.disc) {
+            if (su.parent != -1) articulationPoints.push_back(u);
+            popBCC(u, v);
+        }
+    }
+
+    void finish(Id u) {
+        // Root articulation point check
+        if (vs[u].parent == -1 && rootChildren > 1) articulationPoints.push_back(u);
+    }
+
+    void prefetch(Id w) const { DFS_PREFETCH(&vs[w]); }
+};
+
+/**
+ * @brief Finds the connected components of graph into the flat
+ * offsets/vertices arrays, reusing their capacity. Each component starts
+ * with its lowest vertex.
+ */
+template <typename Id>
+void findConnectedComponents(const BasicCSRGraph<Id>& graph, std::vector<Id>& offsets,
+                             std::vector<Id>& vertices, std::vector<char>& seen) {
+    offsets.assign(1, 0);
+    vertices.clear();
+    reserveGeometric(vertices, (size_t)graph.V);
+    seen.assign(graph.V, 0);
+
+    for (Id i = 0; i < graph.V; i++) {
+        if (seen[i]) continue;
+        // The component's own slice of `vertices` is the BFS queue
+        size_t head = vertices.size();
+        vertices.push_back(i);
+        seen[i] = 1;
+        while (head < vertices.size()) {
+            Id u = vertices[head++];
+            for (Id v : graph.neighborsOf(u)) {
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    vertices.push_back(v);
+                }
+            }
+        }
+        offsets.push_back((Id)vertices.size());
+    }
+}
+
+/**
+ * @brief Finds all BCCs and articulation points of g, one OpenMP task per
+ * connected component. The result lives in ws and stays valid until ws is
+ * used again.
+ */
+template <typename Id>
+const BasicBCCResult<Id>& computeBCCSlotaMadduri(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                                 BasicWorkspace<Id>& ws) {
+    Id clockBase = ws.beginRun(g.V, opts.prefetchDistance);
+    BasicBCCResult<Id>& result = ws.result;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    findConnectedComponents(g, ws.componentOffsets, ws.componentVertices, ws.componentSeen);
+    const std::vector<Id>& offsets = ws.componentOffsets;
+    const std::vector<Id>& vertices = ws.componentVertices;
+    size_t numComponents = offsets.size() - 1;
+    ws.componentSpans.resize(numComponents);
+    int threads = numComponents > 1 ? maxThreads() : 1;
+    if (ws.componentBuffers.size() < (size_t)threads) ws.componentBuffers.resize(threads);
+
+    // Process components in parallel (Slota-Madduri parallelization strategy)
+    // Each component can be processed independently
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(threads)
+#endif
+    {
+#ifdef _OPENMP
+        int thread = omp_get_thread_num();
+#else
+        int thread = 0;
+#endif
+        BasicComponentBuffers<Id>& buffers = ws.componentBuffers[thread];
+        ComponentData<Id> data(buffers, ws.vs, clockBase, opts.summaryOnly);
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (size_t i = 0; i < numComponents; i++) {
+            BasicComponentSpan<Id>& span = ws.componentSpans[i];
+            span.thread = thread;
+            span.edgesBegin = (Id)data.bccEdges.size();
+            span.endsBegin = (Id)data.bccEnds.size();
+            span.pointsBegin = (Id)data.articulationPoints.size();
+            buffers.dfs.reset(offsets[i + 1] - offsets[i], opts.prefetchDistance);
+            for (Id k = offsets[i]; k < offsets[i + 1]; ++k) {
+                Id vertex = vertices[k];
+                if (data.vs[vertex].disc <= clockBase) {
+                    data.vs[vertex].parent = -1; // may be stale
+                    data.rootChildren = 0;
+                    buffers.dfs.run(g, vertex, data);
+                    if (!data.edgeStack.empty()) data.popBCC(-1, -1);
+                }
+            }
+            span.endsEnd = (Id)data.bccEnds.size();
+            span.pointsEnd = (Id)data.articulationPoints.size();
+        }
+#ifdef _OPENMP
+        #pragma omp critical
+#endif
+        result.summary.merge(data.summary);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    // Join the components' parts in component order
+    std::vector<char>& isArticulation = ws.isArticulation;
+    if (!opts.summaryOnly) result.beginBCCs();
+    for (const BasicComponentSpan<Id>& span : ws.componentSpans) {
+        const BasicComponentBuffers<Id>& buffers = ws.componentBuffers[span.thread];
+        if (span.endsEnd > span.endsBegin) {
+            Id base = (Id)result.bccEdges.size() - span.edgesBegin;
+            result.bccEdges.insert(result.bccEdges.end(), buffers.bccEdges.begin() + span.edgesBegin,
+                                   buffers.bccEdges.begin() + buffers.bccEnds[span.endsEnd - 1]);
+            for (Id k = span.endsBegin; k < span.endsEnd; ++k) {
+                result.bccOffsets.push_back(base + buffers.bccEnds[k]);
+            }
+        }
+        for (Id k = span.pointsBegin; k < span.pointsEnd; ++k) {
+            isArticulation[buffers.articulationPoints[k]] = 1;
+        }
+    }
+    ws.publishArticulationPoints();
+    return result;
+}
+
+/**
+ * @brief computeBCCSlotaMadduri on a workspace of its own.
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCCSlotaMadduri(const BasicCSRGraph<Id>& g, const BCCOptions& opts) {
+    BasicWorkspace<Id> ws;
+    computeBCCSlotaMadduri(g, opts, ws);
+    return std::move(ws.result);
+}
@@ -0,0 +1,67 @@
+/*
+ * Counters for the summary-only output mode (--format=summary).
+ *
+ * Engines feed every BCC's edge count in as the BCC is popped, instead of
+ * storing its edge list, so a summary run keeps O(1) state per BCC size
+ * class no matter how many BCCs the graph has. A BCC's size is its number
+ * of distinct edges, parallel copies counted once, as in the text reports:
+ * a doubled edge is a one-edge BCC, reported as a bridge in every engine,
+ * output mode and the query server.
+ */
+
+#pragma once
+
+#include "output_writer.h"
+
+struct BCCSummary {
+    static const int kBuckets = 64; // edge counts fit in 64 bits
+
+    long long bccs = 0;
+    long long bridges = 0;      // BCCs made of a single edge
+    long long largest = 0;      // edges in the largest BCC
+    long long histogram[kBuckets] = {}; // [k]: BCCs with 2^k <= edges < 2^(k+1)
+
+    void addBCC(long long edges) {
+        if (edges <= 0) return;
+        bccs++;
+        if (edges == 1) bridges++;
+        if (edges > largest) largest = edges;
+        histogram[63 - __builtin_clzll((unsigned long long)edges)]++;
+    }
+
+    void merge(const BCCSummary& other) {
+        bccs += other.bccs;
+        bridges += other.bridges;
+        if (other.largest > largest) largest = other.largest;
+        for (int k = 0; k < kBuckets; ++k) histogram[k] += other.histogram[k];
+    }
+};
+
+/**
+ * @brief Prints the summary block. articulationPoints < 0 and s == nullptr
+ * mean the engine did not compute that part.
+ */
+inline void printSummary(OutputWriter& out, const char* title, const BCCSummary* s,
+                         long long articulationPoints) {
+    out << "\n--- " << title << " (summary) ---\n";
+    if (!s) {
+        out << "Number of BCCs: Not computed by this algorithm.\n";
+    } else {
+        out << "Total Biconnected Components (BCCs) found: " << s->bccs << '\n';
+        out << "Bridges: " << s->bridges << '\n';
+        out << "Largest BCC (edges): " << s->largest << '\n';
+    }
+    if (articulationPoints >= 0) {
+        out << "Articulation Points (Cut Vertices): " << articulationPoints << '\n';
+    }
+    if (!s || s->bccs == 0) return;
+
+    out << "BCC size histogram (edges: count):\n";
+    for (int k = 0; k < BCCSummary::kBuckets; ++k) {
+        if (s->histogram[k] == 0) continue;
+        long long lo = 1ll << k, hi = (lo << 1) - 1;
+        out << "  " << lo;
+        if (hi > lo) out << '-' << hi;
+        out << ": " << s->histogram[k] << '\n';
+    }
+}
@@ -0,0 +1,157 @@
+/*
+ * Tarjan's BCC algorithm (p1): a single DFS computing discovery times and
+ * low-links. Edge ids are pushed on a stack as the edges are discovered,
+ * and whenever a tree edge (u, v) has low[v] >= disc[u] the ids down to
+ * it are popped and labelled with the next BCC number. The flat BCC lists
+ * are built from the labels afterwards, so the DFS allocates nothing.
+ * All buffers live in a Workspace, which callers may keep across runs.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "bcc_workspace.h"
+#include "csr_graph.h"
+#include "dfs_engine.h"
+
+/**
+ * @brief Per-call DFS state of Tarjan's algorithm, over workspace buffers.
+ */
+template <typename Id>
+struct TarjanState {
+    const Id* edgeIds; // edge id of every CSR slot
+    BasicBCCResult<Id>& result;
+
+    std::vector<Id>& edgeStack;         // ids of the edges currently on the stack
+    std::vector<BasicDFSVertex<Id>>& vs; // disc/low/parent/parentEdge of every vertex
+    std::vector<char>& isArticulation;
+    Id base;          // records with disc <= base are unvisited
+    Id discoveryTime; // last discovery time handed out
+    Id rootChildren = 0; // DFS tree children of the current root
+    Id numBCCs = 0;      // labels handed out
+
+    TarjanState(const BasicCSRGraph<Id>& g, const Id* ids, BasicWorkspace<Id>& ws, Id clockBase)
+        : edgeIds(ids), result(ws.result), edgeStack(ws.edgeStack), vs(ws.vs),
+          isArticulation(ws.isArticulation), base(clockBase), discoveryTime(clockBase) {
+        edgeStack.clear();
+        reserveGeometric(edgeStack, (size_t)g.E); // every edge is pushed at most once
+        result.edgeToBCC.assign(g.E, -1);
+    }
+
+    /**
+     * @brief Pops edge ids down to and including treeEdge, or the whole
+     * stack when treeEdge == -1, and labels them as the next BCC.
+     */
+    void popBCC(Id treeEdge) {
+        Id label = numBCCs++;
+        while (!edgeStack.empty()) {
+            Id e = edgeStack.back();
+            edgeStack.pop_back();
+            result.edgeToBCC[e] = label;
+            if (e == treeEdge) break;
+        }
+    }
+
+    // ----- IterativeDFS visitor -----
+    void discover(Id u) {
+        // Initialize discovery time and low-link value for u (marks it visited)
+        vs[u].disc = vs[u].low = ++discoveryTime;
+    }
+
+    bool edge(Id u, Id v, Id slot) {
+        Id e = edgeIds[slot];
+        BasicDFSVertex<Id>& su = vs[u];
+        BasicDFSVertex<Id>& sv = vs[v];
+        if (sv.disc <= base) {
+            // Only push edge once: when we discover it (going from lower disc to higher disc)
+            edgeStack.push_back(e);
+            if (su.parent == -1) rootChildren++;
+            sv.parent = u;
+            sv.parentEdge = e;
+            return true;
+        }
+        if (v != su.parent) {
+            // Back edge (and we only push it once, from higher to lower disc time)
+            if (sv.disc < su.disc) edgeStack.push_back(e);
+            su.low = std::min(su.low, sv.disc);
+        } else if (e != su.parentEdge) {
+            // A parallel copy of the tree edge sits above it on the stack,
+            // so it is popped and labelled with the tree edge's BCC
+            edgeStack.push_back(e);
+        }
+        return false;
+    }
+
+    void retreat(Id u, Id v, Id slot) {
+        BasicDFSVertex<Id>& su = vs[u];
+        su.low = std::min(su.low, vs[v].low);
+
+        if (vs[v].low >= su.disc) {
+            if (su.parent != -1) isArticulation[u] = 1; // Not the root
+            popBCC(edgeIds[slot]);
+        }
+    }
+
+    void finish(Id u) {
+        if (vs[u].parent == -1 && rootChildren > 1) isArticulation[u] = 1;
+    }
+
+    void prefetch(Id w) const { DFS_PREFETCH(&vs[w]); }
+};
+
+/**
+ * @brief Finds all BCCs and articulation points of g with Tarjan's algorithm.
+ * The BCCs are numbered in the order they are found (self-loops keep
+ * label -1); the flat lists hold each BCC's canonical edges, sorted. The
+ * result lives in ws and stays valid until ws is used again.
+ */
+template <typename Id>
+const BasicBCCResult<Id>& computeBCCTarjan(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                           BasicWorkspace<Id>& ws) {
+    Id base = ws.beginRun(g.V, opts.prefetchDistance);
+    BasicBCCResult<Id>& result = ws.result;
+    std::vector<Id> recoveredIds;
+    const Id* edgeIds = g.edgeIds;
+    if (!edgeIds) {
+        recoveredIds = csrEdgeIds(g);
+        edgeIds = recoveredIds.data();
+    }
+    TarjanState<Id> state(g, edgeIds, ws, base);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (Id i = 0; i < g.V; ++i) {
+        if (state.vs[i].disc <= base) {
+            state.vs[i].parent = state.vs[i].parentEdge = -1; // may be stale
+            state.rootChildren = 0;
+            ws.dfs.run(g, i, state);
+            if (!state.edgeStack.empty()) state.popBCC(-1);
+        }
+    }
+    for (Id count : distinctEdgesPerLabel(g, edgeIds, result.edgeToBCC, state.numBCCs)) {
+        result.summary.addBCC(count);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    if (!opts.summaryOnly) {
+        csrEdgeList(g, ws.endpoints);
+        groupEdgesByLabel(result, ws.endpoints);
+    }
+    ws.publishArticulationPoints();
+    return result;
+}
+
+/**
+ * @brief computeBCCTarjan on a workspace of its own.
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCCTarjan(const BasicCSRGraph<Id>& g, const BCCOptions& opts) {
+    BasicWorkspace<Id> ws;
+    computeBCCTarjan(g, opts, ws);
+    return std::move(ws.result);
+}
@@ -0,0 +1,527 @@
+/*
+ * Tarjan-Vishkin BCC algorithm (p2), parallel on the OpenMP threads:
+ *   1. BFS spanning forest, one level-synchronous BFS per component: the
+ *      vertices of a level are shared out among the threads, which claim
+ *      unvisited neighbors with a CAS on their parent
+ *   2. preorder numbers and subtree sizes by list ranking the forest's
+ *      Euler tour
+ *   3. low/high values from the non-tree edges, then folded up the tree in
+ *      one reverse-preorder sweep over the preorder-indexed arrays
+ *   4. connected components of the auxiliary graph over the tree edges,
+ *      with a lock-free union-find, Afforest-style: a sample of the edges
+ *      first, then the rest minus those inside the largest component
+ *   5. every edge takes the component of its tree edge
+ * The result is a BCC label per edge. Tree edges are indexed by their child
+ * vertex and all edge passes walk the CSR and its edge ids, so each step
+ * is a few O(V + E) passes (plus the union-find's finds, in step 4) with
+ * O(V) memory beside the graph and the labels. Levels and lists shorter
+ * than kTVParallelGrain run on the calling thread, as does everything
+ * without -fopenmp.
+ *
+ * The spanning forest depends on the thread timing, the BCCs do not: they
+ * are numbered in order of their smallest edge id, so the output is the
+ * same for every thread count.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "csr_graph.h"
+#include "parallel_utils.h"
+
+// Smallest loop worth sharing among the threads
+constexpr int64_t kTVParallelGrain = 2048;
+
+/**
+ * @brief Per-call state of the Tarjan-Vishkin algorithm. `edgeIds` gives
+ * the edge id of every CSR slot of `graph`. A tree edge is identified by
+ * its child vertex v: it is (parentv[v], v), with edge id treeEdge[v], and
+ * v stands for it in the auxiliary graph. Roots have parentv -1 and no
+ * tree edge.
+ */
+template <typename Id>
+struct TarjanVishkinState {
+    Id V = 0, E = 0;
+    const BasicCSRGraph<Id>& graph;
+    const Id* edgeIds;
+
+    // Algorithm data
+    std::vector<Id> parentv;
+    std::vector<Id> treeEdge;
+    std::vector<Id> order;       // BFS order; the children of a vertex are contiguous in it
+    std::vector<Id> roots;       // one per component, ascending
+    std::vector<Id> preorder;
+    std::vector<Id> numDescendants;
+    std::vector<Id> low;
+    std::vector<Id> high;
+    std::vector<Id> uf_parent; // auxiliary graph union-find, over tree edges
+    std::vector<Id> edgeToBCC;
+    Id numBCCs = 0;
+
+    TarjanVishkinState(const BasicCSRGraph<Id>& g, const Id* ids)
+        : V(g.V), E(g.E), graph(g), edgeIds(ids) {}
+
+    // A CSR slot u -> v with edge id e is a tree edge iff e is the tree
+    // edge into one of its endpoints.
+    bool isTreeEdge(Id u, Id v, Id e) const { return treeEdge[v] == e || treeEdge[u] == e; }
+
+    // =============== Step 1: spanning forest ===============
+    // Makes u the parent of v through CSR slot i, unless v was reached first
+    bool claim(Id u, Id v, Id i) {
+        if (atomicLoad(&parentv[v]) != -1 || !compareAndSwap(&parentv[v], (Id)-1, u)) return false;
+        treeEdge[v] = edgeIds[i];
+        return true;
+    }
+
+    // Appends the vertices order[lo..hi) discover to `order` at tail. Each
+    // vertex is scanned by one thread, which writes the children it claimed
+    // in one block, so every vertex's children stay contiguous.
+    void expandLevel(Id lo, Id hi, Id& tail) {
+        if (hi - lo < kTVParallelGrain || maxThreads() == 1) {
+            for (Id k = lo; k < hi; ++k) {
+                Id u = order[k];
+                for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i)
+                    if (claim(u, graph.neighbors[i], i)) order[tail++] = graph.neighbors[i];
+            }
+            return;
+        }
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif
+        {
+            std::vector<Id> found;
+#ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 64) nowait
+#endif
+            for (Id k = lo; k < hi; ++k) {
+                Id u = order[k];
+                for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i)
+                    if (claim(u, graph.neighbors[i], i)) found.push_back(graph.neighbors[i]);
+            }
+            Id at = fetchAdd(&tail, (Id)found.size());
+            std::copy(found.begin(), found.end(), order.begin() + at);
+        }
+    }
+
+    void step1_buildSpanningForest() {
+        order.resize(V);
+        roots.clear();
+        Id tail = 0;
+        for (Id root = 0; root < V; ++root) {
+            if (parentv[root] != -1) continue; // reached from an earlier root
+            roots.push_back(root);
+            parentv[root] = root; // visited while its BFS runs
+            Id head = tail;
+            order[tail++] = root;
+            while (head < tail) {
+                Id levelEnd = tail;
+                expandLevel(head, levelEnd, tail);
+                head = levelEnd;
+            }
+            parentv[root] = -1;
+        }
+    }
+
+    // =============== Step 2: Euler tour ===============
+    // Exclusive prefix count of the entering arcs (ids < V) along the list
+    // `succ` from head. The list is cut at up to 64 splitter arcs per
+    // thread; the pieces are walked in parallel, chained in list order on
+    // one thread, then shifted by their offsets in parallel.
+    std::vector<Id> rankEulerTour(const std::vector<Id>& succ, Id head) {
+        const Id n = (Id)succ.size();
+        std::vector<Id> rank(n), piece(n, -1);
+        std::vector<Id> start{head};
+        piece[head] = 0;
+        Id wanted = std::min<Id>(n, (Id)maxThreads() * 64);
+        for (Id j = 1; j < wanted; ++j) {
+            Id a = (Id)((int64_t)n * j / wanted);
+            if (piece[a] == -1) {
+                piece[a] = (Id)start.size();
+                start.push_back(a);
+            }
+        }
+        const Id pieces = (Id)start.size();
+        std::vector<Id> pieceSum(pieces), nextPiece(pieces);
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(n >= kTVParallelGrain)
+#endif
+        for (Id j = 0; j < pieces; ++j) {
+            Id a = start[j], count = 0, b;
+            while (true) {
+                rank[a] = count;
+                count += a < V;
+                b = succ[a];
+                if (b == -1 || piece[b] != -1) break; // end, or the next piece
+                piece[b] = j;
+                a = b;
+            }
+            pieceSum[j] = count;
+            nextPiece[j] = b == -1 ? -1 : piece[b];
+        }
+
+        std::vector<Id> pieceOffset(pieces);
+        Id offset = 0;
+        for (Id j = 0; j != -1; j = nextPiece[j]) {
+            pieceOffset[j] = offset;
+            offset += pieceSum[j];
+        }
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(n >= kTVParallelGrain)
+#endif
+        for (Id a = 0; a < n; ++a) rank[a] += pieceOffset[piece[a]];
+        return rank;
+    }
+
+    void step2_eulerTourAndNumbering() {
+        // The children of a vertex are contiguous in `order`, so the first
+        // child's position is all the forest needs. Arcs are numbered by
+        // BFS position, which keeps siblings' arcs adjacent.
+        std::vector<Id> position(V);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id k = 0; k < V; ++k) position[order[k]] = k;
+        std::vector<Id> firstChild(V, -1); // by BFS position
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id k = 0; k < V; ++k) {
+            Id p = parentv[order[k]];
+            if (p != -1 && (k == 0 || parentv[order[k - 1]] != p)) firstChild[position[p]] = k;
+        }
+
+        // Arc k enters order[k] from its parent, arc V + k leaves it. Roots
+        // have both arcs too, and the tour of one tree goes on with the
+        // next root, so the whole forest is one list.
+        std::vector<Id> succ(2 * (size_t)V);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id k = 0; k < V; ++k) {
+            Id p = parentv[order[k]];
+            succ[k] = firstChild[k] != -1 ? firstChild[k] : V + k;
+            if (p != -1) {
+                bool lastChild = k + 1 == V || parentv[order[k + 1]] != p;
+                succ[V + k] = lastChild ? V + position[p] : k + 1;
+            }
+        }
+        for (size_t r = 0; r < roots.size(); ++r)
+            succ[V + position[roots[r]]] = r + 1 < roots.size() ? position[roots[r + 1]] : -1;
+
+        // Preorder number: entering arcs before v's. Subtree size: entering
+        // arcs between v's and its leaving arc.
+        std::vector<Id> rank = rankEulerTour(succ, 0);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id k = 0; k < V; ++k) {
+            Id v = order[k], pv = rank[k];
+            preorder[v] = pv;
+            numDescendants[pv] = rank[V + k] - pv;
+        }
+    }
+
+    // =============== Step 3: low/high ===============
+    // Folds the final low/high values of the children of preorder number p
+    // into p's. The subtree of p is [p, p + numDescendants[p]) and its
+    // children's subtrees tile it from p + 1, so no tree links are needed.
+    void foldChildren(Id p) {
+        Id lo = low[p], hi = high[p];
+        for (Id c = p + 1; c < p + numDescendants[p]; c += numDescendants[c]) {
+            lo = std::min(lo, low[c]);
+            hi = std::max(hi, high[c]);
+        }
+        low[p] = lo;
+        high[p] = hi;
+    }
+
+    void step3_computeLowHigh() {
+        // Non-tree edges, in vertex order so the CSR streams; each is seen
+        // from both ends
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1024) if(V >= kTVParallelGrain)
+#endif
+        for (Id u = 0; u < V; u++) {
+            Id pu = preorder[u], lo = pu, hi = pu;
+            for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i) {
+                Id v = graph.neighbors[i];
+                if (isTreeEdge(u, v, edgeIds[i])) continue;
+                lo = std::min(lo, preorder[v]);
+                hi = std::max(hi, preorder[v]);
+            }
+            low[pu] = lo;
+            high[pu] = hi;
+        }
+
+        // One sweep in reverse preorder, over preorder-indexed arrays only.
+        // The largest subtrees of at most `grain` vertices are swept in
+        // parallel, then the vertices above them on one thread.
+        Id grain = std::max<Id>((Id)kTVParallelGrain, V / ((Id)maxThreads() * 8));
+        std::vector<Id> subtrees, above;
+        for (Id p = 0; p < V;) {
+            if (numDescendants[p] <= grain) {
+                subtrees.push_back(p);
+                p += numDescendants[p];
+            } else {
+                above.push_back(p++);
+            }
+        }
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(subtrees.size() > 1)
+#endif
+        for (size_t t = 0; t < subtrees.size(); ++t) {
+            Id root = subtrees[t];
+            for (Id p = root + numDescendants[root]; p-- > root;) foldChildren(p);
+        }
+        for (size_t i = above.size(); i-- > 0;) foldChildren(above[i]);
+    }
+
+    // =============== Step 4: auxiliary graph ===============
+    // Concurrent union-find over the tree edges: a root is linked under
+    // the smaller root with a CAS, so links never close a cycle, and
+    // finds halve their path with path splitting as they go.
+    Id uf_find(Id x) {
+        while (true) {
+            Id p = atomicLoad(&uf_parent[x]), gp = atomicLoad(&uf_parent[p]);
+            if (p == gp) return p;
+            compareAndSwap(&uf_parent[x], p, gp);
+            x = p;
+        }
+    }
+    void uf_unite(Id x, Id y) {
+        while (true) {
+            x = uf_find(x);
+            y = uf_find(y);
+            if (x == y) return;
+            if (x < y) std::swap(x, y);
+            if (compareAndSwap(&uf_parent[x], x, y)) return; // lost a race: retry
+        }
+    }
+    // Points every tree edge straight at its root
+    void uf_compress() {
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id x = 0; x < V; ++x) atomicStore(&uf_parent[x], uf_find(x)); // others still find through x
+    }
+
+    // Rule (i): a non-tree edge (u, v) "glues" the tree edges
+    // (parent(u), u) and (parent(v), v) together when neither endpoint is
+    // a root and u and v are unrelated in the tree. In a BFS tree the only
+    // related non-tree edges are parallel copies of a tree edge, so every
+    // parent-child edge is skipped. Calls f(v) for each such v of u, from
+    // CSR slot `from` on, until f returns false.
+    template <typename F>
+    void forEachGlued(Id u, Id from, F f) {
+        for (Id i = from; i < graph.offsets[u + 1]; ++i) {
+            Id v = graph.neighbors[i];
+            if (v == u || parentv[v] == -1 || v == parentv[u] || parentv[v] == u) continue;
+            if (!f(v, i)) return;
+        }
+    }
+
+    // Afforest-style: unite along a sample of the auxiliary edges first,
+    // find the label most of the tree edges ended up with, then go over
+    // the remaining edges skipping the tree edges that already carry it.
+    // Each skipped edge is still seen from its other end, since rule (i)
+    // edges are scanned from both endpoints.
+    void step4_buildAuxiliaryGraph() {
+        uf_parent.resize(V);
+        std::vector<Id> resume(V); // first CSR slot the last phase has to look at
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id x = 0; x < V; ++x) uf_parent[x] = x;
+
+        // Sample: every rule (ii) pair, and the first rule (i) edge of
+        // each tree edge. Rule (ii): (parent(p), p) and (p, u) are not
+        // separated by an articulation point if u's subtree reaches above
+        // p or outside p's subtree.
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1024) if(V >= kTVParallelGrain)
+#endif
+        for (Id u = 0; u < V; u++) {
+            Id p = parentv[u];
+            resume[u] = graph.offsets[u + 1];
+            if (p == -1) continue;
+            if (parentv[p] != -1) {
+                Id pp = preorder[p], pu = preorder[u];
+                if (low[pu] < pp || high[pu] >= pp + numDescendants[pp]) uf_unite(p, u);
+            }
+            forEachGlued(u, graph.offsets[u], [&](Id v, Id i) {
+                uf_unite(u, v);
+                resume[u] = i + 1;
+                return false;
+            });
+        }
+        uf_compress();
+
+        // The most common label among a fixed sample of tree edges
+        std::vector<Id> sample;
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for (int k = 0; k < 1024; ++k) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            Id x = (Id)((seed >> 11) % (uint64_t)V);
+            if (parentv[x] != -1) sample.push_back(uf_parent[x]);
+        }
+        std::sort(sample.begin(), sample.end());
+        Id giant = -1;
+        size_t best = 0;
+        for (size_t i = 0, j; i < sample.size(); i = j) {
+            for (j = i; j < sample.size() && sample[j] == sample[i];) ++j;
+            if (j - i > best) {
+                best = j - i;
+                giant = sample[i];
+            }
+        }
+
+        // The remaining rule (i) edges, from both ends
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1024) if(V >= kTVParallelGrain)
+#endif
+        for (Id u = 0; u < V; u++) {
+            if (parentv[u] == -1 || uf_find(u) == giant) continue;
+            forEachGlued(u, resume[u], [&](Id v, Id) {
+                uf_unite(u, v);
+                return true;
+            });
+        }
+        uf_compress();
+    }
+
+    // =============== Step 5: edge labels ===============
+    void step5_assignEdges() {
+        // Every tree edge takes the component of its child vertex
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(V >= kTVParallelGrain)
+#endif
+        for (Id v = 0; v < V; v++)
+            if (parentv[v] != -1) edgeToBCC[treeEdge[v]] = uf_parent[v];
+
+        // Step 4 already united the components of both endpoints of a
+        // non-tree edge between unrelated vertices, neither of them a
+        // root, so either will do. A parallel copy of a tree edge goes
+        // with its child. Self-loops belong to no BCC.
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1024) if(V >= kTVParallelGrain)
+#endif
+        for (Id u = 0; u < V; u++) {
+            for (Id i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i) {
+                Id v = graph.neighbors[i];
+                if (v <= u || isTreeEdge(u, v, edgeIds[i])) continue;
+                edgeToBCC[edgeIds[i]] = uf_parent[parentv[v] == u ? v : u];
+            }
+        }
+    }
+
+    // =============== Results ===============
+    // Renumbers the component labels in edgeToBCC to 0-based BCC labels in
+    // order of each BCC's smallest edge id, so the numbering does not
+    // depend on the spanning forest. Edge ids are cut into blocks; each
+    // block counts the first edges it holds, and after a scan of the
+    // counts numbers them from its offset.
+    void numberBCCs() {
+        std::vector<Id> firstEdge(V, E), number(V, -1);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(E >= kTVParallelGrain)
+#endif
+        for (Id e = 0; e < E; ++e)
+            if (edgeToBCC[e] != -1) writeMin(&firstEdge[edgeToBCC[e]], e);
+
+        const Id blocks = std::max<Id>(1, std::min<Id>(E / kTVParallelGrain, (Id)maxThreads() * 4));
+        std::vector<Id> firstEdges(blocks);
+        auto blockBegin = [&](Id b) { return (Id)((int64_t)E * b / blocks); };
+        auto isFirst = [&](Id e) { return edgeToBCC[e] != -1 && firstEdge[edgeToBCC[e]] == e; };
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static, 1) if(blocks > 1)
+#endif
+        for (Id b = 0; b < blocks; ++b) {
+            Id count = 0;
+            for (Id e = blockBegin(b); e < blockBegin(b + 1); ++e) count += isFirst(e);
+            firstEdges[b] = count;
+        }
+        numBCCs = parallelExclusiveScan(firstEdges.data(), (size_t)blocks);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static, 1) if(blocks > 1)
+#endif
+        for (Id b = 0; b < blocks; ++b) {
+            Id next = firstEdges[b];
+            for (Id e = blockBegin(b); e < blockBegin(b + 1); ++e)
+                if (isFirst(e)) number[edgeToBCC[e]] = next++;
+        }
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(E >= kTVParallelGrain)
+#endif
+        for (Id e = 0; e < E; ++e)
+            if (edgeToBCC[e] != -1) edgeToBCC[e] = number[edgeToBCC[e]];
+    }
+
+    // =============== Runner ===============
+    void run() {
+        parentv.assign(V, -1);
+        treeEdge.assign(V, -1);
+        preorder.resize(V);
+        numDescendants.resize(V);
+        low.resize(V);
+        high.resize(V);
+        edgeToBCC.assign(E, -1);
+        if (V == 0) return;
+
+        step1_buildSpanningForest();
+        step2_eulerTourAndNumbering();
+        step3_computeLowHigh();
+        step4_buildAuxiliaryGraph();
+        step5_assignEdges();
+        numberBCCs();
+    }
+};
+
+/**
+ * @brief Finds all BCCs and articulation points of g with the Tarjan-Vishkin
+ * algorithm, on all OpenMP threads. BCCs are numbered in order of their
+ * smallest edge id. `edges`, if given, lists the endpoints of each edge
+ * id and saves recovering them from g for the BCC lists.
+ */
+template <typename Id>
+BasicBCCResult<Id> computeBCCTarjanVishkin(const BasicCSRGraph<Id>& g, const BCCOptions& opts,
+                                           const std::vector<std::pair<Id,Id>>* edges = nullptr) {
+    std::vector<Id> recoveredIds;
+    const Id* edgeIds = g.edgeIds;
+    if (!edgeIds) {
+        recoveredIds = csrEdgeIds(g);
+        edgeIds = recoveredIds.data();
+    }
+
+    BasicBCCResult<Id> result;
+    TarjanVishkinState<Id> tv(g, edgeIds);
+    auto start = std::chrono::high_resolution_clock::now();
+    tv.run();
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    std::vector<char> isArticulation;
+    articulationPointsFromLabels(g, edgeIds, tv.edgeToBCC, isArticulation);
+
+    for (Id count : distinctEdgesPerLabel(g, edgeIds, tv.edgeToBCC, tv.numBCCs))
+        result.summary.addBCC(count);
+    result.edgeToBCC = std::move(tv.edgeToBCC);
+    if (!opts.summaryOnly) {
+        std::vector<std::pair<Id,Id>> recovered;
+        if (!edges) {
+            recovered = csrEdgeList(g);
+            edges = &recovered;
+        }
+        groupEdgesByLabel(result, *edges);
+    }
+
+    result.setArticulationPoints(isArticulation);
+    return result;
+}
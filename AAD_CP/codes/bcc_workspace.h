@@ -0,0 +1,118 @@
+/*
+ * Reusable working memory for the DFS engines (Tarjan, Slota-Madduri,
+ * chain decomposition and the low/disc sweep).
+ *
+ * A process that computes BCCs on many graphs, or on many snapshots of
+ * one graph, can keep one Workspace and pass it to every call:
+ *
+ *   Workspace ws;
+ *   for (const CSRGraph& g : snapshots) {
+ *       const BCCResult& r = computeBCCTarjan(g, opts, ws); // valid until the next call
+ *       ...
+ *   }
+ *
+ * Buffers only grow, at least doubling each time, so back-to-back runs stop
+ * allocating once the largest graph has been seen. The per-vertex DFS
+ * records are never cleared either: the workspace keeps a clock that
+ * advances by V per run, each run stamps discovery times above the clock
+ * base it was given, and every record at or below that base reads as
+ * unvisited. Starting a run is O(1) instead of an O(V) refill; the records
+ * are zeroed only when the clock would overflow Id. The articulation flags
+ * stay all zero between runs: publishArticulationPoints() resets just the
+ * flags the run set.
+ *
+ * A workspace serves one call at a time; threads need one each.
+ */
+
+#pragma once
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "dfs_engine.h"
+
+/**
+ * @brief One Slota-Madduri thread's buffers. The thread appends the BCCs
+ * and articulation points of every component it takes, in the order it
+ * takes them.
+ */
+template <typename Id>
+struct BasicComponentBuffers {
+    std::vector<std::pair<Id, Id>> edgeStack;
+    std::vector<std::pair<Id, Id>> bccEdges;
+    std::vector<Id> bccEnds;             // end of each BCC in bccEdges
+    std::vector<std::pair<Id, Id>> distinctEdges; // scratch: counting a BCC's distinct edges
+    std::vector<Id> articulationPoints;
+    BasicIterativeDFS<Id> dfs;
+};
+
+/**
+ * @brief Where one connected component's output sits in its thread's
+ * BasicComponentBuffers.
+ */
+template <typename Id>
+struct BasicComponentSpan {
+    int thread = 0;
+    Id edgesBegin = 0;                 // its first slot in bccEdges
+    Id endsBegin = 0, endsEnd = 0;     // its BCCs: bccEnds[endsBegin .. endsEnd)
+    Id pointsBegin = 0, pointsEnd = 0; // its articulationPoints range
+};
+
+template <typename Id>
+struct BasicWorkspace {
+    std::vector<BasicDFSVertex<Id>> vs;     // DFS records, stale below the clock base
+    std::vector<char> isArticulation;       // per vertex, all zero between runs
+    std::vector<Id> edgeStack;              // edge ids (Tarjan)
+    std::vector<std::pair<Id, Id>> pairStack; // (u, v) edges (chain, Slota-Madduri)
+    std::vector<Id> preorder;               // vertices by discovery time (sweep)
+    std::vector<Id> vertexLabel;            // BCC of each vertex's tree edge (sweep)
+    std::vector<std::pair<Id, Id>> endpoints; // both ends of every edge id
+    // Slota-Madduri: connected component i is componentVertices[
+    // componentOffsets[i] .. componentOffsets[i + 1]); its output is
+    // described by componentSpans[i] and lives in the buffers of the
+    // thread that ran it
+    std::vector<Id> componentOffsets;
+    std::vector<Id> componentVertices;
+    std::vector<char> componentSeen;        // per vertex, while finding components
+    std::vector<BasicComponentSpan<Id>> componentSpans;
+    std::vector<BasicComponentBuffers<Id>> componentBuffers; // one per thread
+    BasicIterativeDFS<Id> dfs;
+    BasicBCCResult<Id> result;              // the last run's result
+
+    /**
+     * @brief Starts a run on a graph with V vertices: sizes the per-vertex
+     * buffers, empties the result and returns the clock base. The run's
+     * discovery times must lie in base + 1 .. base + V.
+     */
+    Id beginRun(Id V, int prefetchDistance) {
+        if (clock > std::numeric_limits<Id>::max() - V) {
+            for (auto& s : vs) s = BasicDFSVertex<Id>();
+            clock = 0;
+        }
+        reserveGeometric(vs, (size_t)V);
+        vs.resize(V); // records added here start at disc 0
+        reserveGeometric(isArticulation, (size_t)V);
+        isArticulation.resize(V); // entries cut off or added are zero
+        dfs.reset(V, prefetchDistance);
+        result.clear();
+        Id base = clock;
+        clock += V;
+        return base;
+    }
+
+    /**
+     * @brief Ends a run: fills the result's articulation points from the
+     * flags, then clears the flags that were set.
+     */
+    void publishArticulationPoints() {
+        result.setArticulationPoints(isArticulation);
+        for (Id v : result.articulationPoints) isArticulation[v] = 0;
+    }
+
+private:
+    Id clock = 0; // every record with disc <= clock is stale
+};
+using Workspace = BasicWorkspace<int32_t>;
+using Workspace64 = BasicWorkspace<int64_t>;
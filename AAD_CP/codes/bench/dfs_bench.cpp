@@ -0,0 +1,178 @@
+/*
+ * DFS throughput benchmark on deep graphs.
+ *
+ * Builds graphs whose DFS tree is one long path (a path, a cycle, a ladder
+ * and a caterpillar tree, each with n vertices) and times the DFS-based
+ * engines on them, plus any graph files given on the command line. The
+ * recursive DFS overflowed the default 8 MB stack at roughly 10^5 levels;
+ * the iterative engine (dfs_engine.h) only needs 8 bytes of heap per level.
+ * Every engine's BCC count is checked against the expected one;
+ * lowlink-sweep is the edge-stack-free engine (bcc_lowlink_sweep.h).
+ *
+ * --prefetch=d1,d2,... times every engine once per prefetch distance
+ * instead (BCCOptions::prefetchDistance) and reports the speedup of each
+ * over the first one; list 0 first to compare against no prefetching.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -o dfs_bench dfs_bench.cpp
+ * Usage: ./dfs_bench [--prefetch=0,2,4,8,16] [n=1000000] [graph.txt|graph.csr ...]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../bcc_library.h"
+#include "../csr_graph.h"
+
+using namespace std;
+
+/**
+ * @brief Best-of-N wall time of fn() in seconds.
+ */
+template <typename F>
+double bestTime(int reps, F fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        fn();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+struct DeepGraph {
+    string name;
+    CSRGraph graph;
+    long long expectedBCCs; // -1: unknown (files)
+};
+
+CSRGraph fromEdges(int n, vector<pair<int, int>> edges) {
+    EdgeList input;
+    input.V = n;
+    input.E = (int)edges.size();
+    input.edges = move(edges);
+    return buildCSR(input);
+}
+
+// 0 - 1 - 2 - ... - (n-1): n-1 bridges
+DeepGraph makePath(int n) {
+    vector<pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; ++i) edges.push_back({i, i + 1});
+    return {"path", fromEdges(n, move(edges)), n - 1};
+}
+
+// The path closed into a ring: a single BCC
+DeepGraph makeCycle(int n) {
+    vector<pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; ++i) edges.push_back({i, i + 1});
+    edges.push_back({n - 1, 0});
+    return {"cycle", fromEdges(n, move(edges)), 1};
+}
+
+// Two rails 0..k-1 and k..2k-1 with a rung at every position: one BCC,
+// DFS depth n
+DeepGraph makeLadder(int n) {
+    int k = n / 2;
+    vector<pair<int, int>> edges;
+    for (int i = 0; i + 1 < k; ++i) {
+        edges.push_back({i, i + 1});
+        edges.push_back({k + i, k + i + 1});
+    }
+    for (int i = 0; i < k; ++i) edges.push_back({i, k + i});
+    return {"ladder", fromEdges(2 * k, move(edges)), 1};
+}
+
+// A spine 0..k-1 with one leaf hanging off every spine vertex, like the
+// tree_like graphs scaled up: all edges are bridges
+DeepGraph makeCaterpillar(int n) {
+    int k = n / 2;
+    vector<pair<int, int>> edges;
+    for (int i = 0; i + 1 < k; ++i) edges.push_back({i, i + 1});
+    for (int i = 0; i < k; ++i) edges.push_back({i, k + i});
+    return {"caterpillar", fromEdges(2 * k, move(edges)), 2LL * k - 1};
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> distances = {-1}; // -1: the engine default only
+    vector<const char*> args;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--prefetch=", 11) == 0) {
+            distances.clear();
+            stringstream list(argv[i] + 11);
+            string item;
+            while (getline(list, item, ',')) distances.push_back(atoi(item.c_str()));
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    int n = args.empty() ? 1000000 : atoi(args[0]);
+    if (n < 4 || distances.empty()) {
+        cerr << "Usage: " << argv[0] << " [--prefetch=d1,d2,...] [n>=4] [graph.txt|graph.csr ...]\n";
+        return 1;
+    }
+    const int reps = 3;
+
+    vector<DeepGraph> graphs;
+    graphs.push_back(makePath(n));
+    graphs.push_back(makeCycle(n));
+    graphs.push_back(makeLadder(n));
+    graphs.push_back(makeCaterpillar(n));
+    for (size_t i = 1; i < args.size(); ++i) {
+        DeepGraph file{args[i], CSRGraph(), -1};
+        if (!loadGraph(args[i], file.graph)) continue;
+        file.name = file.name.substr(file.name.find_last_of('/') + 1);
+        graphs.push_back(move(file));
+    }
+
+    struct Engine {
+        BCCAlgorithm algorithm;
+        const char* name;
+        bool edgeStackFree;
+    };
+    const Engine engines[] = {
+        {BCCAlgorithm::Tarjan, "tarjan", false},
+        {BCCAlgorithm::SlotaMadduri, "slota-madduri", false},
+        {BCCAlgorithm::Chain, "chain", false},
+        {BCCAlgorithm::Tarjan, "lowlink-sweep", true},
+    };
+
+    cout << left << setw(28) << "graph" << right << setw(10) << "V" << setw(10) << "E"
+         << setw(16) << "engine" << setw(10) << "prefetch" << setw(12) << "seconds"
+         << setw(12) << "Medges/s" << setw(10) << "speedup" << endl;
+    for (const DeepGraph& dg : graphs) {
+        const CSRGraph& g = dg.graph;
+        for (const auto& engine : engines) {
+            BCCOptions opts;
+            opts.algorithm = engine.algorithm;
+            opts.edgeStackFree = engine.edgeStackFree;
+            opts.summaryOnly = true; // time the DFS, not the edge-list copies
+            double baseSeconds = 0;
+            for (int distance : distances) {
+                opts.prefetchDistance = distance;
+                long long bccs = 0;
+                double seconds = bestTime(reps, [&] {
+                    BCCResult r = computeBCC(g, opts);
+                    bccs = r.summary.bccs;
+                });
+                if (baseSeconds == 0) baseSeconds = seconds;
+                cout << left << setw(28) << dg.name << right << setw(10) << g.V << setw(10) << g.E
+                     << setw(16) << engine.name
+                     << setw(10) << (distance < 0 ? string("default") : to_string(distance))
+                     << setw(12) << fixed << setprecision(4) << seconds
+                     << setw(12) << setprecision(1) << g.E / 1e6 / seconds
+                     << setw(9) << setprecision(2) << baseSeconds / seconds << "x";
+                if (dg.expectedBCCs >= 0 && bccs != dg.expectedBCCs) {
+                    cout << "  MISMATCH (" << bccs << " BCCs, expected " << dg.expectedBCCs << ")";
+                }
+                cout << endl;
+            }
+        }
+    }
+    return 0;
+}
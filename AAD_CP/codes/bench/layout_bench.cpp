@@ -0,0 +1,188 @@
+/*
+ * Vertex-state layout microbenchmark for the low-link DFS.
+ *
+ * Runs the same Tarjan kernel (IterativeDFS, edge-id stack, BCC and
+ * articulation point counts) with two layouts of the per-vertex state:
+ *   soa  separate disc / low / parent / parentEdge arrays plus a
+ *        vector<bool> visited (the engines' old layout)
+ *   aos  one packed 16-byte DFSVertex per vertex, visited == (disc != 0)
+ *        (the layout the engines use now)
+ * and reports the best-of-N time of each. Both must find the same counts.
+ *
+ * To see the cache misses behind the times, run one layout at a time
+ * under cachegrind and compare D1mr / DLmr (graph loading is identical in
+ * both runs):
+ *   valgrind --tool=cachegrind --cachegrind-out-file=cg_soa.out ./layout_bench --layout=soa --reps=1 g.txt
+ *   valgrind --tool=cachegrind --cachegrind-out-file=cg_aos.out ./layout_bench --layout=aos --reps=1 g.txt
+ *
+ * Build: g++ -std=c++17 -O2 -o layout_bench layout_bench.cpp
+ * Usage: ./layout_bench [--layout=soa|aos|both] [--reps=N] graph.txt|graph.csr ...
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../csr_graph.h"
+#include "../dfs_engine.h"
+
+using namespace std;
+
+/**
+ * @brief Best-of-N wall time of fn() in seconds.
+ */
+template <typename F>
+double bestTime(int reps, F fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        fn();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Struct of arrays: every field of vertex v lives in a different array
+struct SoALayout {
+    vector<int> discs, lows, parents, parentEdges;
+    vector<bool> visitedBits;
+    explicit SoALayout(int V)
+        : discs(V, 0), lows(V, 0), parents(V, -1), parentEdges(V, -1), visitedBits(V, false) {}
+    bool visited(int v) const { return visitedBits[v]; }
+    void markVisited(int v) { visitedBits[v] = true; }
+    int& disc(int v) { return discs[v]; }
+    int& low(int v) { return lows[v]; }
+    int& parent(int v) { return parents[v]; }
+    int& parentEdge(int v) { return parentEdges[v]; }
+};
+
+// Array of structs: one DFSVertex record per vertex
+struct AoSLayout {
+    vector<DFSVertex> vs;
+    explicit AoSLayout(int V) : vs(V) {}
+    bool visited(int v) const { return vs[v].disc != 0; }
+    void markVisited(int) {} // disc != 0 already says so
+    int& disc(int v) { return vs[v].disc; }
+    int& low(int v) { return vs[v].low; }
+    int& parent(int v) { return vs[v].parent; }
+    int& parentEdge(int v) { return vs[v].parentEdge; }
+};
+
+/**
+ * @brief Tarjan's kernel as in bcc_tarjan.h, over a pluggable layout.
+ */
+template <typename Layout>
+struct LowLinkKernel {
+    const int* edgeIds;
+    Layout st;
+    vector<int> edgeStack;
+    vector<char> isArticulation;
+    int discoveryTime = 0, rootChildren = 0;
+    long long bccs = 0;
+
+    LowLinkKernel(const CSRGraph& g, const int* ids) : edgeIds(ids), st(g.V), isArticulation(g.V, 0) {
+        edgeStack.reserve(g.E);
+    }
+
+    void popBCC(int treeEdge) {
+        while (!edgeStack.empty()) {
+            int e = edgeStack.back();
+            edgeStack.pop_back();
+            if (e == treeEdge) break;
+        }
+        bccs++;
+    }
+
+    void discover(int u) {
+        st.disc(u) = st.low(u) = ++discoveryTime;
+        st.markVisited(u);
+    }
+    bool edge(int u, int v, int slot) {
+        int e = edgeIds[slot];
+        if (!st.visited(v)) {
+            edgeStack.push_back(e);
+            if (st.parent(u) == -1) rootChildren++;
+            st.parent(v) = u;
+            st.parentEdge(v) = e;
+            return true;
+        }
+        if (v != st.parent(u)) {
+            if (st.disc(v) < st.disc(u)) edgeStack.push_back(e);
+            st.low(u) = min(st.low(u), st.disc(v));
+        }
+        return false;
+    }
+    void retreat(int u, int v, int slot) {
+        st.low(u) = min(st.low(u), st.low(v));
+        if (st.low(v) >= st.disc(u)) {
+            if (st.parent(u) != -1) isArticulation[u] = 1;
+            popBCC(edgeIds[slot]);
+        }
+    }
+    void finish(int u) {
+        if (st.parent(u) == -1 && rootChildren > 1) isArticulation[u] = 1;
+    }
+};
+
+/**
+ * @brief Runs the kernel over all of g; returns bccs * 2^32 + articulation points.
+ */
+template <typename Layout>
+long long runKernel(const CSRGraph& g, const int* edgeIds) {
+    LowLinkKernel<Layout> k(g, edgeIds);
+    IterativeDFS dfs(g.V);
+    for (int i = 0; i < g.V; ++i) {
+        if (!k.st.visited(i)) {
+            k.rootChildren = 0;
+            dfs.run(g, i, k);
+            if (!k.edgeStack.empty()) k.popBCC(-1);
+        }
+    }
+    long long aps = 0;
+    for (char a : k.isArticulation) aps += a;
+    return (k.bccs << 32) + aps;
+}
+
+int main(int argc, char* argv[]) {
+    string layout = "both";
+    int reps = 5;
+    vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--layout=", 9) == 0) layout = argv[i] + 9;
+        else if (strncmp(argv[i], "--reps=", 7) == 0) reps = max(1, atoi(argv[i] + 7));
+        else files.push_back(argv[i]);
+    }
+    if (files.empty() || (layout != "soa" && layout != "aos" && layout != "both")) {
+        cerr << "Usage: " << argv[0] << " [--layout=soa|aos|both] [--reps=N] graph.txt|graph.csr ...\n";
+        return 1;
+    }
+    bool soa = layout != "aos", aos = layout != "soa";
+
+    cout << left << setw(32) << "file" << right << setw(10) << "V" << setw(10) << "E"
+         << setw(12) << "soa (s)" << setw(12) << "aos (s)" << setw(10) << "speedup" << endl;
+    for (const char* path : files) {
+        CSRGraph g;
+        if (!loadGraph(path, g)) continue;
+        vector<int> edgeIds = csrEdgeIds(g);
+        string name = path;
+        name = name.substr(name.find_last_of('/') + 1);
+
+        long long soaCounts = 0, aosCounts = 0;
+        double soaTime = soa ? bestTime(reps, [&] { soaCounts = runKernel<SoALayout>(g, edgeIds.data()); }) : 0;
+        double aosTime = aos ? bestTime(reps, [&] { aosCounts = runKernel<AoSLayout>(g, edgeIds.data()); }) : 0;
+
+        cout << left << setw(32) << name << right << setw(10) << g.V << setw(10) << g.E
+             << fixed << setprecision(6) << setw(12) << soaTime << setw(12) << aosTime;
+        if (soa && aos) {
+            cout << setw(9) << setprecision(2) << soaTime / aosTime << "x";
+            if (soaCounts != aosCounts) cout << "  MISMATCH";
+        }
+        cout << endl;
+    }
+    return 0;
+}
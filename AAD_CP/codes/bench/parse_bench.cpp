@@ -0,0 +1,111 @@
+/*
+ * Parse throughput benchmark for the text edge-list loaders.
+ *
+ * For every file it times the tokenizer alone (scalar and AVX2), the
+ * sequential path (scan + buildCSR) and the chunked OpenMP parser at
+ * 1, 2, 4, ... threads, and reports GB/s. The AVX2 scan and the parallel
+ * CSR are checked against their sequential counterparts.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -o parse_bench parse_bench.cpp
+ * Usage: ./parse_bench ../../dataset/real_world/git.txt [more files ...]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "../csr_graph.h"
+
+using namespace std;
+
+/**
+ * @brief Best-of-N wall time of fn() in seconds.
+ */
+template <typename F>
+double bestTime(int reps, F fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        fn();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+bool sameCSR(const CSRGraph& a, const CSRGraph& b) {
+    size_t slots = 2 * (size_t)a.E;
+    return a.V == b.V && a.E == b.E &&
+           memcmp(a.offsets, b.offsets, sizeof(int) * (a.V + 1)) == 0 &&
+           memcmp(a.neighbors, b.neighbors, sizeof(int) * slots) == 0 &&
+           memcmp(a.edgeIds, b.edgeIds, sizeof(int) * slots) == 0;
+}
+
+/**
+ * @brief Tokenizer only: scans every integer pair, no graph is built.
+ */
+long long scanAll(const InputText& text, bool simd) {
+    EdgeScanner scanner(text.begin(), text.end(), simd);
+    long long checksum = 0;
+    int u, v;
+    while (scanner.nextPair(u, v)) checksum += u ^ v;
+    return checksum;
+}
+
+void printRow(const string& name, double mb, const string& stage, double seconds,
+              const char* note = "") {
+    cout << left << setw(36) << name << right << setw(10) << fixed << setprecision(1) << mb
+         << setw(14) << stage << setw(12) << setprecision(4) << seconds
+         << setw(10) << setprecision(3) << mb / 1e3 / seconds << note << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " graph.txt [graph.txt ...]\n";
+        return 1;
+    }
+    const int reps = 3;
+    const int maxT = maxThreads();
+
+    cout << "AVX2 tokenizer: " << (cpuHasAVX2() ? "available" : "not available") << endl;
+    cout << left << setw(36) << "file" << right << setw(10) << "MB"
+         << setw(14) << "stage" << setw(12) << "seconds" << setw(10) << "GB/s" << endl;
+
+    for (int i = 1; i < argc; ++i) {
+        InputText text;
+        if (!text.open(argv[i])) continue;
+        double mb = (text.end() - text.begin()) / 1e6;
+        string name = argv[i];
+        name = name.substr(name.find_last_of('/') + 1);
+
+        long long scalarSum = 0, simdSum = 0;
+        printRow(name, mb, "scan-scalar", bestTime(reps, [&] { scalarSum = scanAll(text, false); }));
+        if (cpuHasAVX2()) {
+            double t = bestTime(reps, [&] { simdSum = scanAll(text, true); });
+            printRow(name, mb, "scan-avx2", t, simdSum == scalarSum ? "" : "  MISMATCH");
+        }
+
+        CSRGraph reference;
+        double seq = bestTime(reps, [&] {
+            EdgeList input;
+            parseEdgeList(text.begin(), text.end(), input);
+            reference = buildCSR(input);
+        });
+        printRow(name, mb, "csr-seq", seq);
+
+#ifdef _OPENMP
+        for (int t = 1; t <= maxT; t *= 2) {
+            omp_set_num_threads(t);
+            CSRGraph g;
+            double par = bestTime(reps, [&] { g = parseCSRParallel<int32_t>(text.begin(), text.end()); });
+            printRow(name, mb, "csr-par-" + to_string(t), par,
+                     sameCSR(reference, g) ? "" : "  MISMATCH");
+            if (t < maxT && t * 2 > maxT) t = maxT / 2; // also run at maxT
+        }
+        omp_set_num_threads(maxT);
+#endif
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Workspace reuse benchmark.
+ *
+ * Times back-to-back computeBCC calls on the same graph, as a process
+ * serving many snapshots would make them: once with every call allocating
+ * its own buffers, and once with one Workspace (bcc_workspace.h) passed to
+ * every call. Times are wall clock per call, allocation included, best of
+ * --reps rounds of --runs calls. Both ways must find the same number of
+ * BCCs and articulation points.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -o workspace_bench workspace_bench.cpp
+ * Usage: ./workspace_bench [--runs=N] [--reps=N] [--summary] graph.txt|graph.csr ...
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../bcc_library.h"
+#include "../bcc_workspace.h"
+#include "../csr_graph.h"
+
+using namespace std;
+
+/**
+ * @brief Best-of-reps wall time of `runs` calls of fn(), per call, in seconds.
+ */
+template <typename F>
+double perCall(int reps, int runs, F fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < runs; ++i) fn();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count() / runs);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int runs = 20, reps = 3;
+    bool summaryOnly = false;
+    vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--runs=", 7) == 0) runs = max(1, atoi(argv[i] + 7));
+        else if (strncmp(argv[i], "--reps=", 7) == 0) reps = max(1, atoi(argv[i] + 7));
+        else if (strcmp(argv[i], "--summary") == 0) summaryOnly = true;
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        cerr << "Usage: " << argv[0] << " [--runs=N] [--reps=N] [--summary] graph.txt|graph.csr ...\n";
+        return 1;
+    }
+
+    struct Engine {
+        BCCAlgorithm algorithm;
+        const char* name;
+        bool edgeStackFree;
+    };
+    const Engine engines[] = {
+        {BCCAlgorithm::Tarjan, "tarjan", false},
+        {BCCAlgorithm::SlotaMadduri, "slota-madduri", false},
+        {BCCAlgorithm::Chain, "chain", false},
+        {BCCAlgorithm::Tarjan, "lowlink-sweep", true},
+    };
+
+    cout << left << setw(32) << "file" << setw(16) << "engine" << right << setw(14) << "fresh(s)"
+         << setw(14) << "workspace(s)" << setw(10) << "speedup" << endl;
+    for (const char* path : files) {
+        CSRGraph g;
+        if (!loadGraph(path, g)) continue;
+        string name = path;
+        name = name.substr(name.find_last_of('/') + 1);
+
+        for (const Engine& engine : engines) {
+            BCCOptions opts;
+            opts.algorithm = engine.algorithm;
+            opts.edgeStackFree = engine.edgeStackFree;
+            opts.summaryOnly = summaryOnly;
+
+            BCCResult fresh;
+            double freshSeconds = perCall(reps, runs, [&] { fresh = computeBCC(g, opts); });
+            Workspace ws;
+            const BCCResult* reused = nullptr;
+            double reusedSeconds = perCall(reps, runs, [&] { reused = &computeBCC(g, opts, ws); });
+            bool ok = fresh.summary.bccs == reused->summary.bccs &&
+                      fresh.articulationPoints == reused->articulationPoints;
+
+            cout << left << setw(32) << name << setw(16) << engine.name << right << fixed
+                 << setprecision(6) << setw(14) << freshSeconds << setw(14) << reusedSeconds
+                 << setprecision(2) << setw(9) << freshSeconds / reusedSeconds << "x"
+                 << (ok ? "" : "  MISMATCH") << endl;
+        }
+    }
+    return 0;
+}
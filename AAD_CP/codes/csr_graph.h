@@ -0,0 +1,628 @@
+/*
+ * Compressed sparse row (CSR) graph shared by the BCC programs, plus a
+ * compact binary on-disk format for it.
+ *
+ * Binary CSR file layout (little endian; id = int32, or int64 with
+ * CSR_WIDE_IDS, every array aligned to its element size):
+ *   CSRFileHeader                 32 bytes
+ *   id offsets[V + 1]             neighbors of u are [offsets[u], offsets[u+1])
+ *   id neighbors[2E]              each undirected edge appears once per endpoint
+ *   id edgeIds[2E]                optional (CSR_HAS_EDGE_IDS), id of the edge
+ *                                 stored in the matching neighbors[] slot
+ * Version 1 files (always int32) are still read.
+ *
+ * A binary file is loaded with mmap and the arrays are used in place, so a
+ * pre-converted graph starts without any parsing. Text files go through
+ * edge_reader.h and are turned into a CSR in memory; when compiled with
+ * -fopenmp the text is split into chunks and parsed on all threads.
+ *
+ * Everything is templated on the id type. CSRGraph (int32_t) covers graphs
+ * with fewer than 2^31 vertices and 2^30 edges; CSRGraph64 (int64_t) covers
+ * anything larger at twice the memory. needsWideIds() reads an input's
+ * header so programs can pick the width before loading.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "edge_reader.h"
+#include "parallel_utils.h"
+
+static const char CSR_MAGIC[8] = {'B', 'C', 'C', 'C', 'S', 'R', '\0', '\1'};
+static const uint32_t CSR_VERSION = 2;
+static const uint32_t CSR_HAS_EDGE_IDS = 1u << 0;
+static const uint32_t CSR_WIDE_IDS = 1u << 1; // arrays are int64 (version 2)
+
+struct CSRFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t numVertices;
+    uint64_t numEdges;
+};
+static_assert(sizeof(CSRFileHeader) == 32, "CSR header must stay 32 bytes");
+
+/**
+ * @brief Contiguous neighbor span of one vertex, usable in range-for.
+ */
+template <typename Id>
+struct BasicNeighborSpan {
+    const Id* first;
+    const Id* last;
+    const Id* begin() const { return first; }
+    const Id* end() const { return last; }
+    Id size() const { return (Id)(last - first); }
+};
+using NeighborSpan = BasicNeighborSpan<int32_t>;
+
+/**
+ * @brief Read-only CSR view. The arrays either live in the owned vectors
+ * (graph built in memory) or inside a mapped binary file.
+ */
+template <typename Id>
+struct BasicCSRGraph {
+    using IdType = Id;
+
+    Id V = 0;
+    Id E = 0;
+    const Id* offsets = nullptr;   // V + 1 entries
+    const Id* neighbors = nullptr; // 2E entries
+    const Id* edgeIds = nullptr;   // 2E entries, or null
+
+    std::vector<Id> offsetStore, neighborStore, edgeIdStore;
+    std::unique_ptr<MappedFile> mapping;
+
+    BasicCSRGraph() = default;
+    BasicCSRGraph(BasicCSRGraph&&) = default;            // vector buffers move with us,
+    BasicCSRGraph& operator=(BasicCSRGraph&&) = default; // so the raw pointers stay valid
+    BasicCSRGraph(const BasicCSRGraph&) = delete;
+    BasicCSRGraph& operator=(const BasicCSRGraph&) = delete;
+
+    Id degree(Id u) const { return offsets[u + 1] - offsets[u]; }
+    const Id* neighborsBegin(Id u) const { return neighbors + offsets[u]; }
+    const Id* neighborsEnd(Id u) const { return neighbors + offsets[u + 1]; }
+    BasicNeighborSpan<Id> neighborsOf(Id u) const { return {neighborsBegin(u), neighborsEnd(u)}; }
+};
+using CSRGraph = BasicCSRGraph<int32_t>;
+using CSRGraph64 = BasicCSRGraph<int64_t>;
+
+/**
+ * @brief Sort key of the undirected edge {u, v}, u <= v: one packed
+ * 64-bit word for 32-bit ids, the pair itself for 64-bit ids.
+ */
+inline uint64_t edgeKey(int32_t u, int32_t v) { return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v; }
+inline std::pair<int64_t, int64_t> edgeKey(int64_t u, int64_t v) { return {u, v}; }
+template <typename Id>
+using EdgeKey = decltype(edgeKey(Id(), Id()));
+
+/**
+ * @brief True if a graph with V vertices and E edges needs 64-bit ids:
+ * vertex ids and the 2E neighbor slots must fit in an int32.
+ */
+inline bool exceeds32BitIds(uint64_t V, uint64_t E) {
+    return V > (uint64_t)INT32_MAX - 1 || E > (uint64_t)INT32_MAX / 2;
+}
+
+/**
+ * @brief Builds a CSR from an edge list in two passes: count degrees,
+ * prefix-sum them into offsets, then scatter each edge into both endpoint
+ * lists. Neighbors keep input order, so traversals visit them in the same
+ * order as the old push_back adjacency lists. If an edge names a vertex
+ * id >= V (a header that undercounts), V is raised to cover it; edges with
+ * a negative endpoint are dropped.
+ */
+template <typename Id>
+BasicCSRGraph<Id> buildCSR(const BasicEdgeList<Id>& input) {
+    BasicCSRGraph<Id> g;
+    Id n = input.V > 0 ? input.V : 0;
+    for (const auto& e : input.edges) {
+        n = std::max(n, std::max(e.first, e.second) + 1);
+    }
+    g.V = n;
+
+    g.offsetStore.assign((size_t)n + 1, 0);
+    Id kept = 0;
+    for (const auto& e : input.edges) {
+        if (e.first < 0 || e.second < 0) continue;
+        g.offsetStore[e.first + 1]++;
+        g.offsetStore[e.second + 1]++;
+        kept++;
+    }
+    for (Id u = 0; u < n; ++u) g.offsetStore[u + 1] += g.offsetStore[u];
+    g.E = kept;
+
+    g.neighborStore.resize(2 * (size_t)kept);
+    g.edgeIdStore.resize(2 * (size_t)kept);
+    std::vector<Id> cursor(g.offsetStore.begin(), g.offsetStore.end() - 1);
+    Id id = 0;
+    for (const auto& e : input.edges) {
+        Id u = e.first, v = e.second;
+        if (u < 0 || v < 0) continue;
+        g.neighborStore[cursor[u]] = v;
+        g.edgeIdStore[cursor[u]++] = id;
+        g.neighborStore[cursor[v]] = u;
+        g.edgeIdStore[cursor[v]++] = id;
+        id++;
+    }
+
+    g.offsets = g.offsetStore.data();
+    g.neighbors = g.neighborStore.data();
+    g.edgeIds = g.edgeIdStore.data();
+    return g;
+}
+
+#ifdef _OPENMP
+/**
+ * @brief Parses a text edge list straight into a CSR on all OpenMP threads.
+ *
+ * The body after the "V E" header is cut into newline-aligned chunks, one
+ * per thread, and each thread scans its chunk into a private edge buffer.
+ * Per-thread degree counts are then merged into the offsets with a parallel
+ * prefix sum, and each thread scatters its own edges. Because thread t
+ * writes after threads 0..t-1 in every neighbor list, the result is
+ * identical to buildCSR() on the sequentially parsed edge list.
+ */
+template <typename Id>
+BasicCSRGraph<Id> parseCSRParallel(const char* begin, const char* end) {
+    BasicCSRGraph<Id> g;
+    EdgeScanner header(begin, end);
+    Id headerV = 0, headerE = 0;
+    if (!header.nextPair(headerV, headerE)) headerV = headerE = 0;
+    const char* body = header.position();
+    const size_t length = (size_t)(end - body);
+
+    // Small inputs are not worth waking the whole team for
+    const size_t minChunk = 1 << 16;
+    int threads = (int)std::min<size_t>(maxThreads(), length / minChunk + 1);
+
+    std::vector<const char*> cut(threads + 1, end);
+    cut[0] = body;
+    for (int t = 1; t < threads; ++t) {
+        const char* p = std::max(body + length * t / threads, cut[t - 1]);
+        const char* nl = static_cast<const char*>(memchr(p, '\n', (size_t)(end - p)));
+        cut[t] = nl ? nl + 1 : end;
+    }
+
+    std::vector<std::vector<std::pair<Id, Id>>> local(threads);
+    #pragma omp parallel for schedule(static, 1) num_threads(threads)
+    for (int t = 0; t < threads; ++t) {
+        EdgeScanner scanner(cut[t], cut[t + 1]);
+        local[t].reserve((size_t)(cut[t + 1] - cut[t]) / 8);
+        Id u, v;
+        while (scanner.nextPair(u, v)) local[t].emplace_back(u, v);
+    }
+
+    // Keep only the first E edges of the file, like the sequential reader
+    long long budget = headerE > 0 ? headerE : 0;
+    for (int t = 0; t < threads; ++t) {
+        if ((long long)local[t].size() > budget) local[t].resize((size_t)budget);
+        budget -= (long long)local[t].size();
+    }
+
+    Id n = headerV > 0 ? headerV : 0;
+    std::vector<Id> keptBefore(threads + 1, 0);
+    #pragma omp parallel for schedule(static, 1) num_threads(threads) reduction(max : n)
+    for (int t = 0; t < threads; ++t) {
+        Id kept = 0;
+        for (const auto& e : local[t]) {
+            n = std::max(n, std::max(e.first, e.second) + 1);
+            if (e.first >= 0 && e.second >= 0) kept++;
+        }
+        keptBefore[t + 1] = kept;
+    }
+    for (int t = 0; t < threads; ++t) keptBefore[t + 1] += keptBefore[t];
+    g.V = n;
+    g.E = keptBefore[threads];
+
+    // Per-thread degree counts
+    std::vector<std::vector<Id>> degree(threads);
+    #pragma omp parallel for schedule(static, 1) num_threads(threads)
+    for (int t = 0; t < threads; ++t) {
+        degree[t].assign(n, 0);
+        for (const auto& e : local[t]) {
+            if (e.first < 0 || e.second < 0) continue;
+            degree[t][e.first]++;
+            degree[t][e.second]++;
+        }
+    }
+
+    // Turn counts into per-thread cursors within each vertex's list
+    g.offsetStore.assign((size_t)n + 1, 0);
+    #pragma omp parallel for schedule(static) num_threads(threads)
+    for (Id u = 0; u < n; ++u) {
+        Id running = 0;
+        for (int t = 0; t < threads; ++t) {
+            Id c = degree[t][u];
+            degree[t][u] = running;
+            running += c;
+        }
+        g.offsetStore[u] = running;
+    }
+    g.offsetStore[n] = parallelExclusiveScan(g.offsetStore.data(), (size_t)n);
+
+    g.neighborStore.resize(2 * (size_t)g.E);
+    g.edgeIdStore.resize(2 * (size_t)g.E);
+    #pragma omp parallel for schedule(static, 1) num_threads(threads)
+    for (int t = 0; t < threads; ++t) {
+        std::vector<Id>& cursor = degree[t];
+        Id id = keptBefore[t];
+        for (const auto& e : local[t]) {
+            Id u = e.first, v = e.second;
+            if (u < 0 || v < 0) continue;
+            Id slotU = g.offsetStore[u] + cursor[u]++;
+            g.neighborStore[slotU] = v;
+            g.edgeIdStore[slotU] = id;
+            Id slotV = g.offsetStore[v] + cursor[v]++;
+            g.neighborStore[slotV] = u;
+            g.edgeIdStore[slotV] = id;
+            id++;
+        }
+    }
+
+    g.offsets = g.offsetStore.data();
+    g.neighbors = g.neighborStore.data();
+    g.edgeIds = g.edgeIdStore.data();
+    return g;
+}
+#endif
+
+/**
+ * @brief Recovers the edge list (indexed by edge id) from a CSR. Each edge
+ * is reported as (smaller, larger) endpoint. Without stored edge ids,
+ * edges are numbered in order of their smaller endpoint. Fills `edges`,
+ * reusing its capacity.
+ */
+template <typename Id>
+void csrEdgeList(const BasicCSRGraph<Id>& g, std::vector<std::pair<Id, Id>>& edges) {
+    edges.assign(g.E, {-1, -1});
+    Id next = 0;
+    for (Id u = 0; u < g.V; ++u) {
+        bool selfLoopOpen = false; // a self-loop fills two slots of u's list
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id v = g.neighbors[i];
+            if (g.edgeIds) {
+                auto& slot = edges[g.edgeIds[i]];
+                if (slot.first == -1) slot = {u, v};
+            } else if (u < v || (u == v && (selfLoopOpen = !selfLoopOpen))) {
+                if (next < g.E) edges[next++] = {u, v};
+            }
+        }
+    }
+}
+
+template <typename Id>
+std::vector<std::pair<Id, Id>> csrEdgeList(const BasicCSRGraph<Id>& g) {
+    std::vector<std::pair<Id, Id>> edges;
+    csrEdgeList(g, edges);
+    return edges;
+}
+
+/**
+ * @brief Edge id of every neighbor slot of g: g.edgeIds when stored,
+ * otherwise ids numbered like csrEdgeList() (by smaller endpoint). The
+ * k-th copy of a parallel edge in u's list is paired with the k-th copy
+ * in v's list, which is how buildCSR scatters them. Returns false if some
+ * slot has no mirror slot to pair with (an asymmetric adjacency), in
+ * which case its id is left at -1.
+ */
+template <typename Id>
+bool csrEdgeIds(const BasicCSRGraph<Id>& g, std::vector<Id>& ids) {
+    size_t slots = (size_t)g.offsets[g.V];
+    if (g.edgeIds) {
+        ids.assign(g.edgeIds, g.edgeIds + slots);
+        return true;
+    }
+
+    ids.assign(slots, -1);
+    std::vector<std::pair<EdgeKey<Id>, Id>> lower, upper; // ((min, max) key, slot)
+    Id next = 0;
+    bool paired = true;
+    for (Id u = 0; u < g.V; ++u) {
+        Id openLoop = -1; // a self-loop fills two slots of u's list
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id v = g.neighbors[i];
+            EdgeKey<Id> key = edgeKey(std::min(u, v), std::max(u, v));
+            if (u == v) {
+                if (openLoop != -1) {
+                    ids[i] = openLoop;
+                    openLoop = -1;
+                } else if (next < g.E) {
+                    ids[i] = openLoop = next++;
+                }
+            } else if (u < v) {
+                if (next < g.E) ids[i] = next++;
+                lower.push_back({key, i});
+            } else {
+                upper.push_back({key, i});
+            }
+        }
+        paired = paired && openLoop == -1;
+    }
+    std::sort(lower.begin(), lower.end());
+    std::sort(upper.begin(), upper.end());
+    paired = paired && lower.size() == upper.size();
+    for (size_t k = 0; k < lower.size() && k < upper.size(); ++k) {
+        if (lower[k].first != upper[k].first) {
+            paired = false;
+            continue;
+        }
+        ids[upper[k].second] = ids[lower[k].second];
+    }
+    return paired && std::find(ids.begin(), ids.end(), (Id)-1) == ids.end();
+}
+
+template <typename Id>
+std::vector<Id> csrEdgeIds(const BasicCSRGraph<Id>& g) {
+    std::vector<Id> ids;
+    csrEdgeIds(g, ids);
+    return ids;
+}
+
+/**
+ * @brief True if every stored edge id of g names exactly two slots, one in
+ * each endpoint's list with the endpoints swapped (both in u's list for a
+ * self-loop at u). One pass over the slots.
+ */
+template <typename Id>
+bool validEdgeIdPairs(const BasicCSRGraph<Id>& g) {
+    const Id done = -2;
+    std::vector<Id> owner(g.E, -1); // vertex whose list holds e's first slot, done after two
+    std::vector<Id> other(g.E);     // neighbor in that first slot
+    for (Id u = 0; u < g.V; ++u) {
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Id e = g.edgeIds[i], v = g.neighbors[i];
+            if (owner[e] == -1) {
+                owner[e] = u;
+                other[e] = v;
+            } else if (owner[e] != done && owner[e] == v && other[e] == u) {
+                owner[e] = done;
+            } else {
+                return false;
+            }
+        }
+    }
+    return std::all_of(owner.begin(), owner.end(), [&](Id o) { return o == done; });
+}
+
+/**
+ * @brief Writes g to path in the binary CSR format.
+ */
+template <typename Id>
+bool writeCSRFile(const char* path, const BasicCSRGraph<Id>& g, bool withEdgeIds) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        std::cerr << "Error: cannot write " << path << "\n";
+        return false;
+    }
+    CSRFileHeader h;
+    memcpy(h.magic, CSR_MAGIC, sizeof(h.magic));
+    h.version = CSR_VERSION;
+    h.flags = (withEdgeIds && g.edgeIds) ? CSR_HAS_EDGE_IDS : 0;
+    if (sizeof(Id) == 8) h.flags |= CSR_WIDE_IDS;
+    h.numVertices = (uint64_t)g.V;
+    h.numEdges = (uint64_t)g.E;
+
+    size_t slots = 2 * (size_t)g.E;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              fwrite(g.offsets, sizeof(Id), (size_t)g.V + 1, f) == (size_t)g.V + 1 &&
+              fwrite(g.neighbors, sizeof(Id), slots, f) == slots;
+    if (ok && (h.flags & CSR_HAS_EDGE_IDS)) {
+        ok = fwrite(g.edgeIds, sizeof(Id), slots, f) == slots;
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) std::cerr << "Error: short write to " << path << "\n";
+    return ok;
+}
+
+/**
+ * @brief True if the file at path starts with the binary CSR magic.
+ */
+inline bool isCSRFile(const char* path) {
+    if (!path) return false;
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char magic[8];
+    bool match = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+                 memcmp(magic, CSR_MAGIC, sizeof(magic)) == 0;
+    fclose(f);
+    return match;
+}
+
+/**
+ * @brief Reads an input's header without loading the graph: V and E of a
+ * binary CSR file, or the "V E" line of a text edge list (0 and 0 when it
+ * has none). `wide` tells whether a CSR file stores 64-bit ids. Returns
+ * false (after an error message) if the input cannot be read.
+ */
+inline bool readGraphHeader(const char* path, int64_t& V, int64_t& E, bool& wide) {
+    V = E = 0;
+    wide = false;
+    if (isCSRFile(path)) {
+        FILE* f = fopen(path, "rb");
+        CSRFileHeader h;
+        bool ok = f && fread(&h, sizeof(h), 1, f) == 1;
+        if (f) fclose(f);
+        if (!ok) {
+            std::cerr << "Error: " << path << " is too small for a CSR header\n";
+            return false;
+        }
+        V = (int64_t)h.numVertices;
+        E = (int64_t)h.numEdges;
+        wide = h.version >= 2 && (h.flags & CSR_WIDE_IDS);
+        return true;
+    }
+    InputText text;
+    if (!text.open(path)) return false;
+    EdgeScanner header(text.begin(), text.end());
+    if (!header.nextPair(V, E)) V = E = 0;
+    return true;
+}
+
+/**
+ * @brief Decides the id width of an input before it is loaded: a binary
+ * CSR file says so in its flags, a text edge list is judged by its
+ * "V E" header. Returns false (after an error message) if the input
+ * cannot be read.
+ */
+inline bool needsWideIds(const char* path, bool& wide) {
+    int64_t V, E;
+    if (!readGraphHeader(path, V, E, wide)) return false;
+    wide = wide || exceeds32BitIds(V > 0 ? V : 0, E > 0 ? E : 0);
+    return true;
+}
+
+/**
+ * @brief Checks the arrays of a binary CSR file in one linear pass, so a
+ * truncated or corrupt file cannot send the engines out of bounds:
+ * offsets start at 0, never decrease and end at 2E, neighbors lie in
+ * [0, V) and edge ids (when `withEdgeIds`) in [0, E).
+ */
+template <typename Id>
+bool validCSRArrays(Id V, Id E, const Id* base, bool withEdgeIds) {
+    const Id* offsets = base;
+    const Id* neighbors = base + V + 1;
+    const Id* edgeIds = neighbors + 2 * (size_t)E;
+    if (offsets[0] != 0 || offsets[V] != 2 * E) return false;
+    bool ok = true;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) reduction(&& : ok) if(V >= (1 << 16))
+#endif
+    for (Id u = 0; u < V; ++u) {
+        ok = ok && offsets[u] <= offsets[u + 1];
+    }
+    if (!ok) return false;
+    Id slots = 2 * E;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) reduction(&& : ok) if(slots >= (1 << 16))
+#endif
+    for (Id i = 0; i < slots; ++i) {
+        ok = ok && neighbors[i] >= 0 && neighbors[i] < V &&
+             (!withEdgeIds || (edgeIds[i] >= 0 && edgeIds[i] < E));
+    }
+    return ok;
+}
+
+/**
+ * @brief Maps a binary CSR file and points g's arrays into the mapping
+ * (no copy) after checking them with validCSRArrays() and checking that
+ * the slots pair up into edges. The mapping stays alive as long as g does.
+ */
+template <typename Id>
+bool loadCSRFile(const char* path, BasicCSRGraph<Id>& g) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path)) {
+        std::cerr << "Error: cannot open input file " << path << "\n";
+        return false;
+    }
+    CSRFileHeader h;
+    if (file->size() < sizeof(h)) {
+        std::cerr << "Error: " << path << " is too small for a CSR header\n";
+        return false;
+    }
+    memcpy(&h, file->data(), sizeof(h));
+    if (memcmp(h.magic, CSR_MAGIC, sizeof(h.magic)) != 0 || h.version < 1 || h.version > CSR_VERSION) {
+        std::cerr << "Error: " << path << " is not a version 1 - " << CSR_VERSION
+                  << " binary CSR file\n";
+        return false;
+    }
+    size_t idBytes = (h.version >= 2 && (h.flags & CSR_WIDE_IDS)) ? 8 : 4;
+    if (idBytes != sizeof(Id)) {
+        std::cerr << "Error: " << path << " stores " << 8 * idBytes << "-bit ids, expected "
+                  << 8 * sizeof(Id) << "-bit\n";
+        return false;
+    }
+    if (sizeof(Id) == 4 && exceeds32BitIds(h.numVertices, h.numEdges)) {
+        std::cerr << "Error: " << path << " is too large for 32-bit ids\n";
+        return false;
+    }
+
+    // Bound the counts by the file size first, so `expected` cannot wrap
+    if (h.numVertices >= file->size() / idBytes || h.numEdges >= file->size() / idBytes) {
+        std::cerr << "Error: " << path << " has size " << file->size() << ", too small for "
+                  << h.numVertices << " vertices and " << h.numEdges << " edges\n";
+        return false;
+    }
+    size_t slots = 2 * (size_t)h.numEdges;
+    size_t expected = sizeof(h) + idBytes * ((size_t)h.numVertices + 1 + slots);
+    if (h.flags & CSR_HAS_EDGE_IDS) expected += idBytes * slots;
+    if (file->size() != expected) {
+        std::cerr << "Error: " << path << " has size " << file->size()
+                  << ", expected " << expected << "\n";
+        return false;
+    }
+
+    const Id* base = reinterpret_cast<const Id*>(file->data() + sizeof(h));
+    if (!validCSRArrays((Id)h.numVertices, (Id)h.numEdges, base, (h.flags & CSR_HAS_EDGE_IDS) != 0)) {
+        std::cerr << "Error: " << path << " is corrupt (offsets or ids out of range)\n";
+        return false;
+    }
+    g = BasicCSRGraph<Id>();
+    g.V = (Id)h.numVertices;
+    g.E = (Id)h.numEdges;
+    g.offsets = base;
+    g.neighbors = base + g.V + 1;
+    g.edgeIds = (h.flags & CSR_HAS_EDGE_IDS) ? g.neighbors + slots : nullptr;
+    g.mapping = std::move(file);
+
+    // Every slot must pair with its mirror slot, or the engines would meet
+    // edges with no id (id-less files) or ids naming other edges
+    std::vector<Id> ids;
+    if (g.edgeIds ? !validEdgeIdPairs(g) : !csrEdgeIds(g, ids)) {
+        std::cerr << "Error: " << path << " is corrupt (adjacency lists do not pair up)\n";
+        g = BasicCSRGraph<Id>();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads a graph from a binary CSR file or a text edge list (path
+ * null or "-" reads text from stdin).
+ */
+template <typename Id>
+bool loadGraph(const char* path, BasicCSRGraph<Id>& g) {
+    if (isCSRFile(path)) return loadCSRFile(path, g);
+    InputText text;
+    if (!text.open(path)) return false;
+#ifdef _OPENMP
+    g = parseCSRParallel<Id>(text.begin(), text.end());
+#else
+    BasicEdgeList<Id> input;
+    parseEdgeList(text.begin(), text.end(), input);
+    g = buildCSR(input);
+#endif
+    return true;
+}
+
+/**
+ * @brief Loads either input kind as a plain edge list, for programs that
+ * validate or index the raw edges themselves. Only edges passing
+ * keep(u, v) are kept; a text input is read on until E edges pass (see
+ * parseEdgeList), a binary one has exactly E edges to choose from.
+ */
+template <typename Id, typename Keep>
+bool loadEdgeList(const char* path, BasicEdgeList<Id>& out, Keep keep) {
+    if (!isCSRFile(path)) return readEdgeList(path, out, keep);
+    BasicCSRGraph<Id> g;
+    if (!loadCSRFile(path, g)) return false;
+    out.V = g.V;
+    out.E = g.E;
+    out.edges.clear();
+    for (const auto& e : csrEdgeList(g)) {
+        if (keep(e.first, e.second)) out.edges.push_back(e);
+    }
+    return true;
+}
+
+template <typename Id>
+bool loadEdgeList(const char* path, BasicEdgeList<Id>& out) {
+    return loadEdgeList(path, out, [](Id, Id) { return true; });
+}
@@ -0,0 +1,172 @@
+/*
+ * Iterative depth-first search over CSR adjacency arrays, shared by every
+ * DFS in the engines (Tarjan, Slota-Madduri, chain decomposition and the
+ * tree passes of Tarjan-Vishkin).
+ *
+ * The recursion is replaced by an explicit stack of (vertex, neighbor
+ * cursor) frames, reserved up front for the deepest possible path, so a
+ * million-vertex path needs 8 MB of heap instead of a million call frames
+ * and the loop never reallocates. What happens at each step is left to a
+ * visitor (Id is the graph's id type, int32_t or int64_t):
+ *
+ *   void discover(Id u);                  // u entered (root or tree child)
+ *   bool edge(Id u, Id v, Id slot);       // next neighbor v of u, at CSR
+ *                                         // position `slot`; return true to
+ *                                         // descend into v as a tree child
+ *   void retreat(Id u, Id v, Id slot);    // v's subtree is done, back at u
+ *   void finish(Id u);                    // all neighbors of u examined
+ *
+ * The calls come in exactly the order the recursive version makes them.
+ *
+ * On large sparse graphs the state of each neighbor v is a cache miss that
+ * edge() stalls on. The engine therefore looks `prefetchDistance` slots
+ * ahead in the current neighbor span. For the vertex w found there it
+ * prefetches offsets[w], which the engine reads if w becomes a child, and
+ * calls the visitor's optional
+ *
+ *   void prefetch(Id w) const;            // hint: w's state is needed soon
+ *
+ * so the visitor can prefetch its own per-vertex record. Distance 0 turns
+ * this off.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+
+template <typename Id>
+struct BasicDFSFrame {
+    Id vertex;
+    Id cursor; // CSR position of the next neighbor to examine
+};
+
+/**
+ * @brief Packed per-vertex state of the low-link DFS engines. Probing a
+ * neighbor touches one record of four ids (16 bytes with 32-bit ids, never
+ * split across cache lines) instead of one entry in each of four arrays;
+ * disc == 0 means the vertex has not been visited, so there is no separate
+ * visited bitmap. Records reused from a Workspace (bcc_workspace.h) count
+ * as unvisited while disc is at or below the run's clock base instead.
+ */
+template <typename Id>
+struct BasicDFSVertex {
+    Id disc = 0;        // discovery time, from 1; 0 = unvisited
+    Id low = 0;         // low-link
+    Id parent = -1;     // DFS tree parent, -1 for a root
+    Id parentEdge = -1; // id of the tree edge (parent, v), where tracked
+};
+using DFSVertex = BasicDFSVertex<int32_t>;
+static_assert(sizeof(DFSVertex) == 16, "DFSVertex must stay 16 bytes");
+static_assert(sizeof(BasicDFSVertex<int64_t>) == 32, "64-bit DFSVertex must stay 32 bytes");
+
+// Read prefetch into all cache levels; a no-op on compilers without it
+#if defined(__GNUC__) || defined(__clang__)
+#define DFS_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+#define DFS_PREFETCH(address) ((void)(address))
+#endif
+
+// Prefetch distance used when none is given; tune with dfs_bench --prefetch
+constexpr int kDefaultPrefetchDistance = 4;
+
+/**
+ * @brief Makes room for n elements in v, at least doubling the capacity
+ * when it has to grow, so buffers reused across runs settle after a few
+ * reallocations.
+ */
+template <typename T>
+void reserveGeometric(std::vector<T>& v, size_t n) {
+    if (v.capacity() < n) v.reserve(std::max(n, 2 * v.capacity()));
+}
+
+template <typename Visitor, typename = void>
+struct HasPrefetch : std::false_type {};
+template <typename Visitor>
+struct HasPrefetch<Visitor, decltype(std::declval<const Visitor&>().prefetch(0))> : std::true_type {};
+
+template <typename Id>
+class BasicIterativeDFS {
+public:
+    /**
+     * @brief Reserves the frame stack for paths of up to maxDepth vertices.
+     * A negative prefetchDistance picks kDefaultPrefetchDistance.
+     */
+    explicit BasicIterativeDFS(Id maxDepth = 0, int prefetchDistance = kDefaultPrefetchDistance) {
+        reset(maxDepth, prefetchDistance);
+    }
+
+    /**
+     * @brief Same as the constructor, for an engine reused across runs:
+     * the frame stack only grows.
+     */
+    void reset(Id maxDepth, int distance = kDefaultPrefetchDistance) {
+        prefetchDistance = distance < 0 ? kDefaultPrefetchDistance : distance;
+        reserveGeometric(frames, maxDepth > 0 ? (size_t)maxDepth : 1);
+    }
+
+    /**
+     * @brief Runs one DFS from root over the CSR arrays (offsets, targets).
+     */
+    template <typename Visitor>
+    void run(const Id* offsets, const Id* targets, Id root, Visitor& visitor) {
+        frames.clear();
+        visitor.discover(root);
+        frames.push_back({root, offsets[root]});
+        prefetchSpan(offsets, targets, offsets[root], offsets[root + 1], visitor);
+
+        while (!frames.empty()) {
+            BasicDFSFrame<Id>& top = frames.back();
+            Id u = top.vertex;
+            Id end = offsets[u + 1];
+            if (top.cursor < end) {
+                Id slot = top.cursor++;
+                if (prefetchDistance && slot + prefetchDistance < end) prefetchSlot(offsets, targets, slot + prefetchDistance, visitor);
+                Id v = targets[slot];
+                if (visitor.edge(u, v, slot)) {
+                    visitor.discover(v);
+                    frames.push_back({v, offsets[v]}); // `top` is dead from here
+                    prefetchSpan(offsets, targets, offsets[v], offsets[v + 1], visitor);
+                }
+                continue;
+            }
+
+            visitor.finish(u);
+            frames.pop_back();
+            if (!frames.empty()) {
+                const BasicDFSFrame<Id>& parent = frames.back();
+                visitor.retreat(parent.vertex, u, parent.cursor - 1);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void run(const BasicCSRGraph<Id>& g, Id root, Visitor& visitor) {
+        run(g.offsets, g.neighbors, root, visitor);
+    }
+
+private:
+    std::vector<BasicDFSFrame<Id>> frames;
+    int prefetchDistance;
+
+    template <typename Visitor>
+    void prefetchSlot(const Id* offsets, const Id* targets, Id slot, const Visitor& visitor) const {
+        Id w = targets[slot];
+        DFS_PREFETCH(offsets + w);
+        if constexpr (HasPrefetch<Visitor>::value) visitor.prefetch(w);
+    }
+
+    // Warms up the first prefetchDistance slots of a span just entered; the
+    // main loop keeps the window ahead of the cursor from there on
+    template <typename Visitor>
+    void prefetchSpan(const Id* offsets, const Id* targets, Id first, Id end, const Visitor& visitor) const {
+        if (prefetchDistance == 0) return;
+        Id last = std::min(end, first + prefetchDistance);
+        for (Id slot = first; slot < last; ++slot) prefetchSlot(offsets, targets, slot, visitor);
+    }
+};
+using IterativeDFS = BasicIterativeDFS<int32_t>;
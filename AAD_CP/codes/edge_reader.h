@@ -0,0 +1,386 @@
+/*
+ * Shared edge-list loader used by all BCC programs (p1 - p5).
+ *
+ * The input file is mapped with mmap and scanned in place with a small
+ * hand-written integer scanner, instead of running getline + stringstream
+ * for every edge. When no path is given the whole of stdin is read into a
+ * buffer and scanned the same way, so `./p1 < graph.txt` keeps working.
+ *
+ * Input format (unchanged):
+ *   # comment lines (optional, '#' in the first column)
+ *   <num_vertices> <num_edges>
+ *   <vertex_u> <vertex_v>
+ *   ...
+ *
+ * Blank lines, comment lines and lines that do not start with two integers
+ * are skipped, exactly like the old getline/stringstream loops. The
+ * tokenizer uses AVX2 when the CPU has it (picked at runtime, no special
+ * compiler flags needed) and a scalar scanner otherwise.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define EDGE_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Graph as read from the text input: header counts plus raw edges.
+ * edges.size() may be smaller than E if the input ends early. Id is the
+ * vertex / edge id type (int32_t, or int64_t for graphs past 2^31 slots).
+ */
+template <typename Id>
+struct BasicEdgeList {
+    Id V = 0;
+    Id E = 0;
+    std::vector<std::pair<Id, Id>> edges;
+};
+using EdgeList = BasicEdgeList<int32_t>;
+using EdgeList64 = BasicEdgeList<int64_t>;
+
+/**
+ * @brief Read-only memory mapping of a whole file (RAII).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const char* path) {
+        close();
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) return false;
+        struct stat st;
+        if (fstat(fd_, &st) != 0) { close(); return false; }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) return true; // mmap rejects empty mappings
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) { close(); return false; }
+        madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+        return true;
+    }
+
+    void close() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    int fd_ = -1;
+};
+
+/**
+ * @brief True if the running CPU supports AVX2 (checked once).
+ */
+inline bool cpuHasAVX2() {
+#ifdef EDGE_SCANNER_X86
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Line-oriented scanner over an in-memory buffer [begin, end).
+ * Does not require the buffer to be NUL-terminated.
+ *
+ * On CPUs with AVX2 the common line shape "<digits> <digits>..." is
+ * handled 32 bytes at a time: one load yields newline, digit and blank
+ * masks for the whole line, and both numbers are converted together with
+ * SSE multiply-add. Any other line (signs, more than 8 digits, lines longer
+ * than 32 bytes, the last 32 bytes of the buffer) goes through the scalar
+ * parser, so both paths accept exactly the same input.
+ */
+class EdgeScanner {
+public:
+    EdgeScanner(const char* begin, const char* end, bool simd = cpuHasAVX2())
+        : begin_(begin), p_(begin), end_(end), simd_(simd) {}
+
+    /** @brief Start of the first line not consumed yet. */
+    const char* position() const { return p_; }
+
+    /**
+     * @brief Advances to the next line that starts with two integers.
+     * @return false once the buffer is exhausted.
+     */
+    template <typename T>
+    bool nextPair(T& a, T& b) {
+#ifdef EDGE_SCANNER_X86
+        if (simd_) return nextPairAVX2(a, b);
+#endif
+        return nextPairScalar(a, b);
+    }
+
+private:
+    template <typename T>
+    bool nextPairScalar(T& a, T& b) {
+        while (p_ < end_) {
+            const char* lineEnd = static_cast<const char*>(
+                memchr(p_, '\n', static_cast<size_t>(end_ - p_)));
+            if (!lineEnd) lineEnd = end_;
+            const char* q = p_;
+            p_ = lineEnd < end_ ? lineEnd + 1 : end_;
+            if (parseLine(q, lineEnd, a, b)) return true;
+        }
+        return false;
+    }
+
+#ifdef EDGE_SCANNER_X86
+    template <typename T>
+    __attribute__((target("avx2")))
+    bool nextPairAVX2(T& a, T& b) {
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i zero = _mm256_set1_epi8('0');
+        const __m256i nine = _mm256_set1_epi8(9);
+
+        while (end_ - p_ >= 32) {
+            const char* q = p_;
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q));
+            uint32_t nlMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline));
+            if (nlMask == 0) {
+                // Line longer than one block: rare, use the scalar parser
+                const char* lineEnd = static_cast<const char*>(
+                    memchr(q + 32, '\n', static_cast<size_t>(end_ - q - 32)));
+                if (!lineEnd) lineEnd = end_;
+                p_ = lineEnd < end_ ? lineEnd + 1 : end_;
+                if (parseLine(q, lineEnd, a, b)) return true;
+                continue;
+            }
+
+            int lineLen = __builtin_ctz(nlMask);
+            const char* lineEnd = q + lineLen;
+            p_ = lineEnd + 1;
+            if (lineLen == 0 || *q == '#') continue;
+
+            __m256i shifted = _mm256_sub_epi8(block, zero);
+            __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, nine), shifted);
+            __m256i isBlank = _mm256_or_si256(_mm256_cmpeq_epi8(block, space),
+                                              _mm256_cmpeq_epi8(block, tab));
+            uint32_t lineMask = (1u << lineLen) - 1;
+            uint32_t digits = (uint32_t)_mm256_movemask_epi8(isDigit) & lineMask;
+            uint32_t blanks = (uint32_t)_mm256_movemask_epi8(isBlank) & lineMask;
+
+            // Expected shape: blank* digit{1,8} blank+ digit{1,8} <anything>
+            bool fast = digits != 0;
+            int start1 = 0, end1 = 0, start2 = 0, end2 = 0;
+            if (fast) {
+                start1 = __builtin_ctz(digits);
+                uint32_t lead = (1u << start1) - 1;
+                end1 = __builtin_ctz(~digits & (~0u << start1));
+                uint32_t rest = digits & (~0u << end1);
+                fast = (blanks & lead) == lead && rest != 0;
+                if (fast) {
+                    start2 = __builtin_ctz(rest);
+                    uint32_t gap = ((1u << start2) - 1) & ~((1u << end1) - 1);
+                    end2 = __builtin_ctz(~digits & (~0u << start2));
+                    fast = (blanks & gap) == gap && end1 - start1 <= 8 &&
+                           end2 - start2 <= 8 && q + end1 - 8 >= begin_;
+                }
+            }
+            if (!fast) {
+                if (parseLine(q, lineEnd, a, b)) return true;
+                continue;
+            }
+            int x, y;
+            convertPair(q + end1, end1 - start1, q + end2, end2 - start2, x, y);
+            a = x;
+            b = y;
+            return true;
+        }
+        return nextPairScalar(a, b);
+    }
+
+    /**
+     * @brief Converts two digit runs of at most 8 digits, each given by its
+     * end pointer and length, with one multiply-add pipeline: digits are
+     * right-aligned in the two 64-bit lanes, then combined pairwise
+     * (x10), into 4-digit groups (x100) and into 8-digit values (x10000).
+     */
+    __attribute__((target("avx2")))
+    static void convertPair(const char* end1, int len1, const char* end2, int len2,
+                            int& a, int& b) {
+        __m128i x = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(end1 - 8)),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(end2 - 8)));
+        const __m128i index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7);
+        __m128i firstKept = _mm_unpacklo_epi64(_mm_set1_epi8((char)(7 - len1)),
+                                               _mm_set1_epi8((char)(7 - len2)));
+        x = _mm_and_si128(x, _mm_cmpgt_epi8(index, firstKept)); // drop bytes before the run
+        __m128i d = _mm_subs_epu8(x, _mm_set1_epi8('0'));         // dropped bytes stay 0
+
+        __m128i pairs = _mm_maddubs_epi16(d, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1,
+                                                           10, 1, 10, 1, 10, 1, 10, 1));
+        __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+        __m128i packed = _mm_packus_epi32(quads, quads);
+        __m128i values = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1,
+                                                               10000, 1, 10000, 1));
+        a = _mm_cvtsi128_si32(values);
+        b = _mm_extract_epi32(values, 1);
+    }
+#endif
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    /**
+     * @brief Parses the first two integers of the line [q, lineEnd).
+     * Blank and '#' lines, and lines without two integers, are rejected.
+     */
+    template <typename T>
+    static bool parseLine(const char* q, const char* lineEnd, T& a, T& b) {
+        if (q == lineEnd || *q == '#') return false;
+        return parseInt(q, lineEnd, a) && parseInt(q, lineEnd, b);
+    }
+
+    /**
+     * @brief Parses one (optionally signed) decimal integer, skipping leading
+     * blanks, the way `stream >> int` does. Like the stream, it fails on a
+     * value outside T's range.
+     */
+    template <typename T>
+    static bool parseInt(const char*& q, const char* lineEnd, T& out) {
+        while (q < lineEnd && isBlank(*q)) ++q;
+        bool negative = false;
+        if (q < lineEnd && (*q == '-' || *q == '+')) {
+            negative = (*q == '-');
+            ++q;
+        }
+        if (q == lineEnd || *q < '0' || *q > '9') return false;
+        const unsigned long long limit =
+            (unsigned long long)std::numeric_limits<T>::max() + (negative ? 1 : 0);
+        unsigned long long value = 0;
+        while (q < lineEnd && *q >= '0' && *q <= '9') {
+            unsigned d = (unsigned)(*q - '0');
+            if (value > (limit - d) / 10) return false;
+            value = value * 10 + d;
+            ++q;
+        }
+        out = negative ? static_cast<T>(0ull - value) : static_cast<T>(value);
+        return true;
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    bool simd_;
+};
+
+/**
+ * @brief Parses the "V E" header and edges until E of them pass keep(u, v)
+ * or the input ends. Rejected pairs are dropped and do not count toward E,
+ * like the per-edge read loops of p2 and p4 that skipped invalid lines.
+ * out.V is set before the first call to keep.
+ */
+template <typename Id, typename Keep>
+void parseEdgeList(const char* begin, const char* end, BasicEdgeList<Id>& out, Keep keep) {
+    EdgeScanner scanner(begin, end);
+    out = BasicEdgeList<Id>();
+    if (!scanner.nextPair(out.V, out.E)) return;
+
+    out.edges.reserve(out.E > 0 ? (size_t)out.E : 0);
+    Id u, v;
+    while ((Id)out.edges.size() < out.E && scanner.nextPair(u, v)) {
+        if (keep(u, v)) out.edges.emplace_back(u, v);
+    }
+}
+
+/**
+ * @brief Parses the "V E" header and up to E edges from a text buffer.
+ */
+template <typename Id>
+void parseEdgeList(const char* begin, const char* end, BasicEdgeList<Id>& out) {
+    parseEdgeList(begin, end, out, [](Id, Id) { return true; });
+}
+
+/**
+ * @brief The raw text of an input: a mapped file, or all of stdin read
+ * into a buffer when path is null or "-".
+ */
+class InputText {
+public:
+    bool open(const char* path) {
+        if (path && strcmp(path, "-") != 0) {
+            if (!file_.open(path)) {
+                std::cerr << "Error: cannot open input file " << path << "\n";
+                return false;
+            }
+            begin_ = file_.data();
+            end_ = file_.data() + file_.size();
+            return true;
+        }
+
+        // stdin fallback: slurp everything once, then scan the buffer in
+        // place. The buffer is kept, so stdin can be opened again (the id
+        // width probe reads the header before the real load).
+        static std::vector<char> buffer;
+        static bool read = false;
+        if (!read) {
+            char chunk[1 << 16];
+            size_t n;
+            while ((n = fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+                buffer.insert(buffer.end(), chunk, chunk + n);
+            }
+            read = true;
+        }
+        begin_ = buffer.data();
+        end_ = buffer.data() + buffer.size();
+        return true;
+    }
+
+    const char* begin() const { return begin_; }
+    const char* end() const { return end_; }
+
+private:
+    MappedFile file_;
+    const char* begin_ = nullptr;
+    const char* end_ = nullptr;
+};
+
+/**
+ * @brief Loads an edge list from a file path (via mmap), or from stdin
+ * when path is null or "-". With `keep`, edges are read until E of them
+ * pass it (see parseEdgeList).
+ * @return false if the file could not be opened.
+ */
+template <typename Id, typename Keep>
+bool readEdgeList(const char* path, BasicEdgeList<Id>& out, Keep keep) {
+    InputText text;
+    if (!text.open(path)) return false;
+    parseEdgeList(text.begin(), text.end(), out, keep);
+    return true;
+}
+
+template <typename Id>
+bool readEdgeList(const char* path, BasicEdgeList<Id>& out) {
+    return readEdgeList(path, out, [](Id, Id) { return true; });
+}
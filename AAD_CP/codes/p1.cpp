@@ -1,194 +1,112 @@
 #include <iostream>
 #include <vector>
-#include <stack>
 #include <algorithm>
-#include <set>
-#include <sstream>
 #include <string>
+#include <chrono>
 
-using namespace std;
-
-// --- Global Variables (replaces class members) ---
-int V; // Number of vertices
-vector<vector<int>> adj; // Adjacency list
-
-// Stores the edges currently on the stack
-stack<pair<int, int>> edgeStack;
-
-// --- DFS discovery arrays ---
-vector<int> disc, low, parent;
-vector<bool> visited;
-
-// discoveryTime: A counter for discovery time
-// bccCount: A counter for the number of BCCs found
-int discoveryTime, bccCount; 
-
-// --- BCC Storage ---
-set<int> articulationPoints;
-vector<vector<pair<int, int>>> bccList;
-
-
-// --- Standalone Functions ---
-
-/**
- * @brief The recursive DFS utility for finding BCCs
- * @param u The current vertex being visited
- */
-void dfsBCC(int u) {
-    // Initialize discovery time and low-link value for u
-    disc[u] = low[u] = ++discoveryTime; 
-    visited[u] = true;
-    int children = 0; // Count of children in the DFS tree
+#include "batch_runner.h"
+#include "bcc_lowlink_sweep.h"
+#include "bcc_tarjan.h"
+#include "csr_graph.h"
+#include "output_writer.h"
+#include "result_output.h"
 
-    for (int v : adj[u]) {
-        // Only push edge once: when we discover it (going from lower disc to higher disc)
-        if (!visited[v]) {
-            edgeStack.push({u, v});
-        }
-        else if (v != parent[u] && disc[v] < disc[u]) {
-            // Back edge (and we only push it once, from higher to lower disc time)
-            edgeStack.push({u, v});
-        }
-
-        if (!visited[v]) {
-            children++;
-            parent[v] = u;
-            dfsBCC(v);
-
-            low[u] = min(low[u], low[v]);
-
-            if (low[v] >= disc[u]) {
-                if (parent[u] != -1) { // Not the root
-                    articulationPoints.insert(u);
-                }
-                
-                bccCount++;
-                vector<pair<int, int>> currentBCC;
-                pair<int, int> edge;
-                do {
-                    edge = edgeStack.top();
-                    edgeStack.pop();
-                    currentBCC.push_back(edge);
-                } while (edge.first != u || edge.second != v);
-                bccList.push_back(currentBCC);
-            }
-        } 
-        else if (v != parent[u]) {
-            low[u] = min(low[u], disc[v]);
-        }
-    }
+using namespace std;
 
-    if (parent[u] == -1 && children > 1) {
-        articulationPoints.insert(u);
-    }
-}
+// The algorithm itself lives in bcc_tarjan.h; this file reads the graph and prints.
 
 /**
- * @brief Function to add an undirected edge
+ * @brief Prints the BCCs and articulation points as text
  */
-void addEdge(int u, int v) {
-    adj[u].push_back(v);
-    adj[v].push_back(u);
-}
+template <typename Id>
+void printResults(const BasicBCCResult<Id>& result, FILE* outFile) {
+    // Buffered, written out in large chunks
+    OutputWriter out(outFile);
+    out << "\n--- Tarjan's Algorithm Results ---\n";
+    out << "Total Biconnected Components (BCCs) found: " << result.numBCCs() << '\n';
+    for (Id i = 0; i < (Id)result.numBCCs(); ++i) {
+        BasicEdgeSpan<Id> edges = result.bcc(i); // canonical (min, max), sorted, parallel copies once
+        out << "BCC " << (i + 1);
 
-/**
- * @brief Main function to find and print all BCCs
- */
-void findBCCs() {
-    for (int i = 0; i < V; ++i) {
-        if (!visited[i]) {
-            dfsBCC(i);
-            if (!edgeStack.empty()) {
-                bccCount++;
-                vector<pair<int, int>> currentBCC;
-                while (!edgeStack.empty()) {
-                    currentBCC.push_back(edgeStack.top());
-                    edgeStack.pop();
-                }
-                bccList.push_back(currentBCC);
-            }
-        }
-    }
-    
-    // --- Print the results ---
-    cout << "\n--- Tarjan's Algorithm Results ---" << endl;
-    cout << "Total Biconnected Components (BCCs) found: " << bccCount << endl;
-    for (int i = 0; i < bccList.size(); ++i) {
-        cout << "BCC " << (i + 1);
-        
         // Determine type: Bridge (1 edge) or Triangle/Component (multiple edges)
-        if (bccList[i].size() == 1) {
-            cout << " (Bridge): ";
+        if (edges.size() == 1) {
+            out << " (Bridge): ";
         } else {
-            cout << " (Triangle " << (i + 1) << "): ";
-        }
-        
-        // Use set to avoid duplicate edges
-        set<pair<int, int>> uniqueEdges;
-        for (const auto& edge : bccList[i]) {
-            int u = edge.first;
-            int v = edge.second;
-            uniqueEdges.insert({min(u, v), max(u, v)});
+            out << " (Triangle " << (i + 1) << "): ";
         }
-        
-        cout << "{";
+
+        out << "{";
         bool first = true;
-        for (const auto& edge : uniqueEdges) {
-            if (!first) cout << ", ";
-            cout << "(" << edge.first << ", " << edge.second << ")";
+        for (const auto& edge : edges) {
+            if (!first) out << ", ";
+            out << "(" << edge.first << ", " << edge.second << ")";
             first = false;
         }
-        cout << "}" << endl;
+        out << "}\n";
     }
 
-    cout << "\nArticulation Points (Cut Vertices): ";
-    if (articulationPoints.empty()) {
-        cout << "None";
+    out << "\nArticulation Points (Cut Vertices): ";
+    if (result.articulationPoints.empty()) {
+        out << "None";
     } else {
-        for (int ap : articulationPoints) {
-            cout << ap << " ";
+        for (Id ap : result.articulationPoints) {
+            out << ap << " ";
         }
     }
-    cout << endl;
+    out << '\n';
 }
 
-// --- Main execution ---
-int main() {
-    int E; // Number of edges
-    
-    // Skip comment lines (lines starting with #)
-    string line;
-    while (getline(cin, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        stringstream ss(line);
-        if (ss >> V >> E) break;
-    }
-
-    // --- Initialization (replaces constructor) ---
-    discoveryTime = 0;
-    bccCount = 0;
-    adj.resize(V);
-    disc.resize(V, 0);
-    low.resize(V, 0);
-    parent.resize(V, -1);
-    visited.resize(V, false);
-    // ---------------------------------------------
+/**
+ * @brief Loads the graph with Id-wide vertex and edge ids, runs the engine
+ * and writes the result to outFile.
+ */
+template <typename Id>
+int run(const RunOptions& opts, FILE* outFile) {
+    auto loadStart = chrono::high_resolution_clock::now();
+    BasicCSRGraph<Id> graph;
+    if (!loadGraph(opts.inputPath, graph)) return 1;
+    double loadSeconds = chrono::duration<double>(chrono::high_resolution_clock::now() - loadStart).count();
 
-    // Read edges, skipping comments
-    for (int i = 0; i < E; ++i) {
-        int u, v;
-        while (getline(cin, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            stringstream ss(line);
-            if (ss >> u >> v) {
-                addEdge(u, v);
-                break;
-            }
-        }
+    // Run the algorithm
+    BCCOptions bccOpts;
+    bccOpts.summaryOnly = opts.format == OutputFormat::Summary;
+    BasicBCCResult<Id> result = computeReordered(graph, opts.order, true, [&](const BasicCSRGraph<Id>& g) {
+        return opts.edgeStackFree ? computeBCCLowLinkSweep(g, bccOpts) : computeBCCTarjan(g, bccOpts);
+    });
+    printReorderTime(opts, result);
+
+    if (opts.format == OutputFormat::Text) {
+        printResults(result, outFile);
+        return 0;
+    }
+    if (bccOpts.summaryOnly) {
+        OutputWriter out(outFile);
+        printSummary(out, "Tarjan's Algorithm Results", &result.summary,
+                     (long long)result.articulationPoints.size());
+        return 0;
     }
+    return writeResult(opts, makeResultRecord("tarjan", graph, result, loadSeconds), outFile) ? 0 : 1;
+}
 
-    // Run the algorithm
-    findBCCs();
+/**
+ * @brief Runs one input, with 32-bit ids unless its header says the graph
+ * needs more.
+ */
+int runFile(const RunOptions& opts, FILE* outFile) {
+    bool wide;
+    if (!needsWideIds(opts.inputPath, wide)) return 1;
+    return wide ? run<int64_t>(opts, outFile) : run<int32_t>(opts, outFile);
+}
 
-    return 0;
-}
\ No newline at end of file
+// --- Main execution ---
+// Usage: ./p1 [graph.txt | graph.csr] [--format=text|summary|json|bin] [--output=path]
+//        [--reorder=none|bfs|rcm|degree|dfs] [--no-edge-stack]
+//        (reads stdin when no file is given)
+//    or: ./p1 files and directories ... [--jobs=N] [--output=dir]  (batch mode, batch_runner.h)
+int main(int argc, char* argv[]) {
+    RunOptions opts;
+    if (!parseRunOptions(argc, argv, opts)) return 1;
+
+    if (!opts.batchInputs.empty()) return runBatch("p1", opts, runFile);
+    return runFile(opts, stdout);
+}
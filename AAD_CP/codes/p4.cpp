@@ -1,152 +1,119 @@
 #include <iostream>
 #include <vector>
-#include <set>
-#include <queue> // For BFS, matching the Python code
 #include <string>
-#include <sstream>
+#include <chrono>
 
-using namespace std;
-
-/**
- * @brief Helper function to count reachable nodes using BFS,
- * matching the Python _count_reachable_nodes function.
- * @param num_nodes Total number of nodes in the graph.
- * @param start_node The node to start the BFS from.
- * @param removed_vertex The vertex to ignore during traversal.
- * @param adj The adjacency list of the graph.
- * @return The total count of reachable nodes.
- */
-int countReachableNodes(int num_nodes, int start_node, int removed_vertex, const vector<vector<int>>& adj) {
-    if (start_node == removed_vertex) {
-        return 0;
-    }
+#include "batch_runner.h"
+#include "bcc_naive.h"
+#include "bcc_summary.h"
+#include "csr_graph.h"
+#include "output_writer.h"
+#include "result_output.h"
 
-    vector<bool> visited(num_nodes, false);
-    queue<int> q;
-
-    q.push(start_node);
-    visited[start_node] = true;
-    int count = 0;
-
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
-        count++;
+using namespace std;
 
-        for (int v : adj[u]) {
-            if (v == removed_vertex || visited[v]) {
-                continue;
-            }
-            visited[v] = true;
-            q.push(v);
-        }
-    }
-    return count;
-}
+// The algorithm itself lives in bcc_naive.h; this file reads the graph and prints.
 
 /**
- * @brief Finds all articulation points using the naive O(V * (V+E)) method.
- * Matches the Python find_articulation_points_naive function.
- * @param num_nodes Total number of nodes in the graph.
- * @param adj The adjacency list of the graph.
- * @return A set of articulation point (cut vertex) IDs.
+ * @brief Loads the graph with Id-wide vertex and edge ids, runs the engine
+ * and writes the result to outFile.
  */
-set<int> findArticulationPointsNaive(int num_nodes, const vector<vector<int>>& adj) {
-    if (num_nodes <= 2) {
-        return set<int>(); // Return empty set
-    }
-
-    set<int> articulation_points;
-
-    for (int v_to_remove = 0; v_to_remove < num_nodes; ++v_to_remove) {
-        // Pick a valid start node from the remaining graph
-        int start_node = -1;
-        for (int i = 0; i < num_nodes; ++i) {
-            if (i != v_to_remove) {
-                start_node = i;
-                break;
-            }
-        }
-
-        if (start_node == -1) {
-            continue; // Should only happen for V=1, which is handled
-        }
-
-        // Count how many nodes are reachable in the graph *without* v_to_remove
-        int reachable_count = countReachableNodes(num_nodes, start_node, v_to_remove, adj);
-
-        if (reachable_count < num_nodes - 1) {
-            articulation_points.insert(v_to_remove);
+template <typename Id>
+int run(const RunOptions& opts, FILE* outFile) {
+    bool text = opts.format == OutputFormat::Text;
+    bool machine = opts.format == OutputFormat::Json || opts.format == OutputFormat::Binary;
+    OutputWriter out(outFile);
+
+    auto loadStart = chrono::high_resolution_clock::now();
+    // Keep only valid edges, reading on until the header's edge count is met,
+    // then build the CSR adjacency in one go
+    BasicEdgeList<Id> valid;
+    auto keep = [&](Id u, Id v) {
+        Id num_nodes = valid.V;
+        if (u >= num_nodes || v >= num_nodes || u < 0 || v < 0) {
+            string note = "Invalid edge: (" + to_string(u) + ", " + to_string(v) +
+                          "). Nodes must be between 0 and " + to_string(num_nodes - 1) + ".\n";
+            // outFile may carry the JSON result, so diagnostics go to stderr then
+            if (machine) cerr << note;
+            else out << note;
+            return false;
         }
+        return true;
+    };
+    if (!loadEdgeList(opts.inputPath, valid, keep)) return 1;
+    Id num_nodes = valid.V;
+    out.flush();
+    if ((Id)valid.edges.size() < valid.E) {
+        cerr << "Error reading edge " << valid.edges.size() << endl;
     }
-    return articulation_points;
-}
-
-int main() {
-    int num_nodes, num_edges;
-    
-    // Skip comment lines and read V E
-    string line;
-    while (getline(cin, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        stringstream ss(line);
-        if (ss >> num_nodes >> num_edges) break;
+    valid.E = (Id)valid.edges.size();
+    BasicCSRGraph<Id> graph = buildCSR(valid);
+    double loadSeconds = chrono::duration<double>(chrono::high_resolution_clock::now() - loadStart).count();
+
+    if (text) {
+        out << "\n--- Graph Input Complete ---\n";
+        out << "Graph has " << num_nodes << " nodes.\n";
+        out.flush();
     }
 
-    // Use vector<vector<int>> for adjacency list
-    vector<vector<int>> adj_list(num_nodes);
-
-    // Read edges, skipping comments
-    for (int i = 0; i < num_edges; ++i) {
-        int u, v;
-        bool success = false;
-        while (getline(cin, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            stringstream ss(line);
-            if (ss >> u >> v) {
-                if (u >= num_nodes || v >= num_nodes || u < 0 || v < 0) {
-                    cout << "Invalid edge: (" << u << ", " << v << "). Nodes must be between 0 and " << (num_nodes - 1) << "." << endl;
-                    continue;
-                }
-                adj_list[u].push_back(v);
-                adj_list[v].push_back(u);
-                success = true;
-                break;
-            }
-        }
-        if (!success) {
-            cerr << "Error reading edge " << i << endl;
-            break;
-        }
-    }
-
-    cout << "\n--- Graph Input Complete ---" << endl;
-    cout << "Graph has " << num_nodes << " nodes." << endl;
-
     // --- Find Articulation Points ---
-    set<int> aps = findArticulationPointsNaive(num_nodes, adj_list);
+    BasicBCCResult<Id> result = computeReordered(graph, opts.order, false, [](const BasicCSRGraph<Id>& g) {
+        return computeBCCNaive(g, BCCOptions());
+    });
+    printReorderTime(opts, result);
+    const vector<Id>& aps = result.articulationPoints;
+
+    if (opts.format == OutputFormat::Summary) {
+        printSummary(out, "Naive Algorithm Results", nullptr, (long long)aps.size());
+        return 0;
+    }
+    if (machine) {
+        return writeResult(opts, makeResultRecord("naive", graph, result, loadSeconds), outFile) ? 0 : 1;
+    }
 
     // --- CHANGED OUTPUT FORMAT ---
-    cout << "\n--- Naive Algorithm Results ---" << endl;
+    out << "\n--- Naive Algorithm Results ---\n";
     
-    cout << "Articulation Points: ";
+    out << "Articulation Points: ";
     if (aps.empty()) {
-        cout << "None";
+        out << "None";
     } else {
-        cout << "{";
+        out << "{";
         bool first = true;
-        for (int ap : aps) {
+        for (Id ap : aps) {
             if (!first) {
-                cout << ", ";
+                out << ", ";
             }
-            cout << ap;
+            out << ap;
             first = false;
         }
-        cout << "}";
+        out << "}";
     }
-    cout << endl;
+    out << '\n';
 
-    cout << "Number of BCCs: Not computed by this naive algorithm." << endl;
+    out << "Number of BCCs: Not computed by this naive algorithm.\n";
 
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Runs one input, with 32-bit ids unless its header says the graph
+ * needs more.
+ */
+int runFile(const RunOptions& opts, FILE* outFile) {
+    bool wide;
+    if (!needsWideIds(opts.inputPath, wide)) return 1;
+    return wide ? run<int64_t>(opts, outFile) : run<int32_t>(opts, outFile);
+}
+
+// Usage: ./p4 [graph.txt | graph.csr] [--format=text|summary|json|bin] [--output=path]
+//        [--reorder=none|bfs|rcm|degree|dfs]
+//        (reads stdin when no file is given)
+//    or: ./p4 files and directories ... [--jobs=N] [--output=dir]  (batch mode, batch_runner.h)
+int main(int argc, char* argv[]) {
+    RunOptions opts;
+    if (!parseRunOptions(argc, argv, opts, false)) return 1; // no --no-edge-stack
+
+    if (!opts.batchInputs.empty()) return runBatch("p4", opts, runFile);
+    return runFile(opts, stdout);
+}
@@ -0,0 +1,123 @@
+/*
+ * Small OpenMP helpers shared by the BCC programs.
+ *
+ * Everything here also compiles without -fopenmp (p1, p2, p4 and p5 are
+ * built that way by default); the helpers then run on one thread.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Number of threads an OpenMP parallel region would use (1 without OpenMP).
+ */
+inline int maxThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Atomic accesses to plain arrays shared by OpenMP threads (GCC/Clang
+// builtins, so the arrays stay std::vector<Id>). Relaxed ordering: the
+// parallel regions' barriers order everything else.
+
+/**
+ * @brief Atomic read of *p.
+ */
+template <typename T>
+T atomicLoad(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Atomic write of value to *p.
+ */
+template <typename T>
+void atomicStore(T* p, T value) {
+    __atomic_store_n(p, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Sets *p to desired if it holds expected; true if it did.
+ */
+template <typename T>
+bool compareAndSwap(T* p, T expected, T desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Lowers *p to value if value is smaller; true if it did.
+ */
+template <typename T>
+bool writeMin(T* p, T value) {
+    T current = atomicLoad(p);
+    while (value < current) {
+        if (__atomic_compare_exchange_n(p, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Adds x to *p and returns the previous value.
+ */
+template <typename T>
+T fetchAdd(T* p, T x) {
+    return __atomic_fetch_add(p, x, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Replaces a[0..n) with its exclusive prefix sum and returns the total.
+ * Blocked two-pass scan: each thread sums its block, the block sums are
+ * scanned, then each thread rewrites its block starting from its offset.
+ */
+template <typename T>
+T parallelExclusiveScan(T* a, size_t n) {
+    int threads = maxThreads();
+    if (threads <= 1 || n < 4096) {
+        T running = 0;
+        for (size_t i = 0; i < n; ++i) {
+            T x = a[i];
+            a[i] = running;
+            running += x;
+        }
+        return running;
+    }
+
+#ifdef _OPENMP
+    std::vector<T> blockSum(threads + 1, 0);
+    int used = 1;
+    #pragma omp parallel num_threads(threads)
+    {
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        size_t lo = n * t / nt, hi = n * (t + 1) / nt;
+        T sum = 0;
+        for (size_t i = lo; i < hi; ++i) sum += a[i];
+        blockSum[t + 1] = sum;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            used = nt;
+            for (int b = 0; b < nt; ++b) blockSum[b + 1] += blockSum[b];
+        } // implicit barrier after single
+        T running = blockSum[t];
+        for (size_t i = lo; i < hi; ++i) {
+            T x = a[i];
+            a[i] = running;
+            running += x;
+        }
+    }
+    return blockSum[used];
+#else
+    return 0; // unreachable: maxThreads() is 1 without OpenMP
+#endif
+}
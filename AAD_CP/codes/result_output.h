@@ -0,0 +1,334 @@
+/*
+ * Machine-readable result output shared by the BCC programs (p1 - p5).
+ *
+ * Every engine accepts
+ *   ./pN [graph.txt | graph.csr] [--format=text|summary|json|bin] [--output=path]
+ *        [--reorder=none|bfs|rcm|degree|dfs] [--no-edge-stack]
+ * (--no-edge-stack only in p1, p3 and p5; several inputs or a directory
+ * switch to batch mode, see batch_runner.h)
+ * `text` (the default) keeps the human-readable report and `summary` prints
+ * only counts and a BCC size histogram (bcc_summary.h). `json` and `bin`
+ * emit the same three pieces of information instead:
+ *   - an edge -> BCC label array indexed by edge id (-1: edge is in no BCC,
+ *     e.g. a self-loop), BCCs numbered from 0 in the engine's report order
+ *   - an articulation-point bitmap over the V vertices
+ *   - a timing block (load and compute seconds)
+ *
+ * Binary result file layout (little endian), written through mmap:
+ *   ResultFileHeader              96 bytes
+ *   int32 edgeToBCC[E]            only with RESULT_HAS_BCCS, padded to 8 bytes
+ *                                 (int64 with RESULT_WIDE_LABELS: 64-bit ids)
+ *   uint64 articulationBits[(V + 63) / 64]   bit (v % 64) of word v / 64
+ *
+ * JSON goes to stdout unless --output is given; `bin` needs --output.
+ * scripts/bcc_results.py loads either form.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bcc_result.h"
+#include "csr_graph.h"
+#include "output_writer.h"
+#include "vertex_order.h"
+
+enum class OutputFormat { Text, Summary, Json, Binary };
+
+struct RunOptions {
+    const char* inputPath = nullptr; // null: read stdin
+    std::vector<const char*> batchInputs; // batch mode: files and directories (batch_runner.h)
+    int jobs = 0;                    // batch mode: worker threads, 0: one per hardware thread
+    OutputFormat format = OutputFormat::Text;
+    const char* outputPath = nullptr; // null: stdout (text and json only)
+    VertexOrder order = VertexOrder::None; // renumber vertices before the engine runs
+    bool edgeStackFree = false; // p1, p3, p5: label BCCs by a low/disc sweep (bcc_lowlink_sweep.h)
+};
+
+/**
+ * @brief Parses the command line shared by all engines. Prints the usage
+ * line and returns false on anything it does not understand, including
+ * --no-edge-stack when the engine has no sweep variant (edgeStackFlag
+ * false).
+ */
+inline bool parseRunOptions(int argc, char* argv[], RunOptions& opts, bool edgeStackFlag = true) {
+    bool ok = true;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc && ok; ++i) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--format=", 9) == 0) {
+            std::string fmt = arg + 9;
+            if (fmt == "text") opts.format = OutputFormat::Text;
+            else if (fmt == "summary") opts.format = OutputFormat::Summary;
+            else if (fmt == "json") opts.format = OutputFormat::Json;
+            else if (fmt == "bin") opts.format = OutputFormat::Binary;
+            else ok = false;
+        } else if (strncmp(arg, "--output=", 9) == 0 && arg[9] != '\0') {
+            opts.outputPath = arg + 9;
+        } else if (strncmp(arg, "--reorder=", 10) == 0) {
+            ok = parseVertexOrder(arg + 10, opts.order);
+        } else if (strcmp(arg, "--no-edge-stack") == 0 && edgeStackFlag) {
+            opts.edgeStackFree = true;
+        } else if (strncmp(arg, "--jobs=", 7) == 0) {
+            opts.jobs = atoi(arg + 7);
+            ok = opts.jobs > 0;
+        } else if (arg[0] == '-' && arg[1] == '-') {
+            ok = false;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    struct stat st;
+    if (inputs.size() == 1 && !(stat(inputs[0], &st) == 0 && S_ISDIR(st.st_mode))) {
+        opts.inputPath = inputs[0];
+    } else {
+        opts.batchInputs = inputs;
+    }
+    if (ok && opts.format == OutputFormat::Binary && !opts.outputPath) {
+        std::cerr << "Error: --format=bin needs --output=path\n";
+        return false;
+    }
+    if (!ok) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [graph.txt | graph.csr | files and directories ...]"
+                     " [--format=text|summary|json|bin] [--output=path]"
+                     " [--reorder=none|bfs|rcm|degree|dfs]"
+                  << (edgeStackFlag ? " [--no-edge-stack]" : "") << " [--jobs=N]\n";
+    }
+    return ok;
+}
+
+/**
+ * @brief Reports the renumbering time on stderr when --reorder was used,
+ * so the regular output stays the same.
+ */
+template <typename Id>
+void printReorderTime(const RunOptions& opts, const BasicBCCResult<Id>& result) {
+    if (opts.order == VertexOrder::None) return;
+    std::cerr << "Reordering (" << vertexOrderName(opts.order) << "): "
+              << result.reorderSeconds << " seconds\n";
+}
+
+/**
+ * @brief Everything a machine-readable result carries, built from an
+ * engine's BCCResult by makeResultRecord(). Labels are Id wide.
+ */
+template <typename Id>
+struct BasicResultRecord {
+    const char* algorithm = "";
+    Id V = 0;
+    Id E = 0;
+    Id numBCCs = -1;                     // -1: the engine does not compute BCCs
+    std::vector<Id> edgeToBCC;           // per edge id; empty when numBCCs == -1
+    std::vector<uint64_t> articulationBits;
+    Id numArticulationPoints = 0;
+    double loadSeconds = 0;
+    double computeSeconds = 0;
+};
+
+using ResultRecord = BasicResultRecord<int32_t>;
+
+/**
+ * @brief Fills r.edgeToBCC from the flat (u, v) BCC lists of b, BCC i
+ * getting label i. Each pair is matched to an edge id of g through a
+ * sorted (min, max) index; parallel copies of an edge that the engine
+ * reported once (or not at all) inherit the label of their twin.
+ */
+template <typename Id>
+void labelEdgesFromBCCs(BasicResultRecord<Id>& r, const BasicCSRGraph<Id>& g,
+                        const BasicBCCResult<Id>& b) {
+    std::vector<std::pair<EdgeKey<Id>, Id>> index(g.E);
+    std::vector<std::pair<Id, Id>> edges = csrEdgeList(g);
+    for (Id e = 0; e < g.E; ++e) {
+        Id u = edges[e].first, v = edges[e].second;
+        index[e] = {edgeKey(std::min(u, v), std::max(u, v)), e};
+    }
+    std::sort(index.begin(), index.end());
+
+    r.edgeToBCC.assign(g.E, -1);
+    r.numBCCs = 0;
+    for (Id i = 0; i < (Id)b.numBCCs(); ++i) {
+        Id label = r.numBCCs++;
+        for (const auto& edge : b.bcc(i)) {
+            EdgeKey<Id> key = edgeKey(std::min(edge.first, edge.second), std::max(edge.first, edge.second));
+            auto it = std::lower_bound(index.begin(), index.end(), std::make_pair(key, (Id)-1));
+            while (it != index.end() && it->first == key && r.edgeToBCC[it->second] != -1) ++it;
+            if (it != index.end() && it->first == key) r.edgeToBCC[it->second] = label;
+        }
+    }
+
+    // Parallel edges always share a BCC
+    for (size_t i = 0; i < index.size();) {
+        size_t j = i;
+        Id label = -1;
+        for (; j < index.size() && index[j].first == index[i].first; ++j) {
+            if (label == -1) label = r.edgeToBCC[index[j].second];
+        }
+        for (size_t k = i; k < j; ++k) {
+            if (r.edgeToBCC[index[k].second] == -1) r.edgeToBCC[index[k].second] = label;
+        }
+        i = j;
+    }
+}
+
+/**
+ * @brief Builds the machine-readable record of an engine's result on g.
+ */
+template <typename Id>
+BasicResultRecord<Id> makeResultRecord(const char* algorithm, const BasicCSRGraph<Id>& g,
+                                       const BasicBCCResult<Id>& b, double loadSeconds) {
+    BasicResultRecord<Id> r;
+    r.algorithm = algorithm;
+    r.V = g.V;
+    r.E = g.E;
+    if (b.hasBCCs && !b.edgeToBCC.empty()) {
+        r.edgeToBCC = b.edgeToBCC;
+        r.numBCCs = (Id)b.summary.bccs;
+    } else if (b.hasBCCs) {
+        labelEdgesFromBCCs(r, g, b);
+    }
+    r.articulationBits = b.articulationBits;
+    r.numArticulationPoints = (Id)b.articulationPoints.size();
+    r.loadSeconds = loadSeconds;
+    r.computeSeconds = b.seconds;
+    return r;
+}
+
+static const char RESULT_MAGIC[8] = {'B', 'C', 'C', 'R', 'E', 'S', '\0', '\1'};
+static const uint32_t RESULT_VERSION = 2;
+static const uint32_t RESULT_HAS_BCCS = 1u << 0;
+static const uint32_t RESULT_WIDE_LABELS = 1u << 1; // edgeToBCC is int64 (v2)
+
+struct ResultFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    int64_t numBCCs;
+    uint64_t numArticulationPoints;
+    double loadSeconds;
+    double computeSeconds;
+    char algorithm[32];
+};
+static_assert(sizeof(ResultFileHeader) == 96, "result header must stay 96 bytes");
+
+/**
+ * @brief Writes r as JSON. The bitmap is a hex string of ceil(V / 8) bytes,
+ * byte i holding vertices 8i .. 8i+7 (lowest bit first).
+ */
+template <typename Id>
+void writeResultJSON(OutputWriter& out, const BasicResultRecord<Id>& r) {
+    static const char kHex[] = "0123456789abcdef";
+    out << "{\n  \"algorithm\": \"" << r.algorithm << "\",\n";
+    out << "  \"vertices\": " << r.V << ",\n  \"edges\": " << r.E << ",\n";
+    out << "  \"bccs\": ";
+    if (r.numBCCs < 0) out << "null";
+    else out << r.numBCCs;
+    out << ",\n  \"articulationPoints\": " << r.numArticulationPoints << ",\n";
+
+    out << "  \"edgeToBCC\": ";
+    if (r.numBCCs < 0) {
+        out << "null";
+    } else {
+        out << '[';
+        for (size_t i = 0; i < r.edgeToBCC.size(); ++i) {
+            if (i > 0) out << ',';
+            out << r.edgeToBCC[i];
+        }
+        out << ']';
+    }
+
+    out << ",\n  \"articulationBitmap\": \"";
+    for (size_t byte = 0; byte < ((size_t)r.V + 7) / 8; ++byte) {
+        unsigned bits = (unsigned)(r.articulationBits[byte / 8] >> (8 * (byte % 8))) & 0xff;
+        out << kHex[bits >> 4] << kHex[bits & 15];
+    }
+    out << "\",\n  \"timing\": {\"loadSeconds\": " << r.loadSeconds
+        << ", \"computeSeconds\": " << r.computeSeconds << "}\n}\n";
+}
+
+/**
+ * @brief Writes r in the binary result format: the file is sized up front,
+ * mapped, and the arrays are copied straight into the mapping.
+ */
+template <typename Id>
+bool writeResultBinary(const char* path, const BasicResultRecord<Id>& r) {
+    bool hasBCCs = r.numBCCs >= 0;
+    size_t labelBytes = hasBCCs ? ((sizeof(Id) * (size_t)r.E + 7) & ~(size_t)7) : 0;
+    size_t bitmapBytes = sizeof(uint64_t) * r.articulationBits.size();
+    size_t total = sizeof(ResultFileHeader) + labelBytes + bitmapBytes;
+
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error: cannot write " << path << "\n";
+        return false;
+    }
+    if (ftruncate(fd, (off_t)total) != 0) {
+        std::cerr << "Error: cannot size " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "Error: cannot map " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    char* base = static_cast<char*>(p);
+
+    ResultFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, RESULT_MAGIC, sizeof(h.magic));
+    h.version = RESULT_VERSION;
+    h.flags = (hasBCCs ? RESULT_HAS_BCCS : 0) | (sizeof(Id) == 8 ? RESULT_WIDE_LABELS : 0);
+    h.numVertices = (uint64_t)r.V;
+    h.numEdges = (uint64_t)r.E;
+    h.numBCCs = r.numBCCs;
+    h.numArticulationPoints = (uint64_t)r.numArticulationPoints;
+    h.loadSeconds = r.loadSeconds;
+    h.computeSeconds = r.computeSeconds;
+    strncpy(h.algorithm, r.algorithm, sizeof(h.algorithm) - 1);
+    memcpy(base, &h, sizeof(h)); // the padding bytes are already zero (ftruncate)
+
+    if (hasBCCs) memcpy(base + sizeof(h), r.edgeToBCC.data(), sizeof(Id) * (size_t)r.E);
+    memcpy(base + sizeof(h) + labelBytes, r.articulationBits.data(), bitmapBytes);
+
+    bool ok = munmap(p, total) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok) std::cerr << "Error: short write to " << path << "\n";
+    return ok;
+}
+
+/**
+ * @brief Emits r in the format chosen on the command line (json or bin).
+ * JSON goes to opts.outputPath when set, to `out` otherwise.
+ */
+template <typename Id>
+bool writeResult(const RunOptions& opts, const BasicResultRecord<Id>& r, FILE* out = stdout) {
+    if (opts.format == OutputFormat::Binary) return writeResultBinary(opts.outputPath, r);
+
+    FILE* f = out;
+    if (opts.outputPath && !(f = fopen(opts.outputPath, "w"))) {
+        std::cerr << "Error: cannot write " << opts.outputPath << "\n";
+        return false;
+    }
+    {
+        OutputWriter out(f);
+        writeResultJSON(out, r);
+    }
+    return f == out || fclose(f) == 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Locality-improving vertex renumbering.
+ *
+ * Input files number vertices arbitrarily, so neighbors of a vertex sit
+ * far apart in the per-vertex arrays and every DFS / BFS step is a cache
+ * miss. reorderGraph() computes a new numbering, rebuilds the CSR in that
+ * order (edge ids are kept), and restoreOriginalIds() maps an engine's
+ * result on the renumbered graph back to the input ids:
+ *   bfs     breadth-first visit order, one component after another
+ *   rcm     Reverse Cuthill-McKee: BFS from a minimum-degree vertex,
+ *           neighbors taken by increasing degree, whole order reversed
+ *   degree  highest degree first (hubs packed together)
+ *   dfs     preorder of a first depth-first pass
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bcc_result.h"
+#include "csr_graph.h"
+#include "dfs_engine.h"
+
+/**
+ * @brief Parses a --reorder value; returns false if it names no order.
+ */
+inline bool parseVertexOrder(const std::string& name, VertexOrder& order) {
+    if (name == "none") order = VertexOrder::None;
+    else if (name == "bfs") order = VertexOrder::BFS;
+    else if (name == "rcm") order = VertexOrder::RCM;
+    else if (name == "degree") order = VertexOrder::Degree;
+    else if (name == "dfs") order = VertexOrder::DFS;
+    else return false;
+    return true;
+}
+
+inline const char* vertexOrderName(VertexOrder order) {
+    switch (order) {
+        case VertexOrder::BFS:    return "bfs";
+        case VertexOrder::RCM:    return "rcm";
+        case VertexOrder::Degree: return "degree";
+        case VertexOrder::DFS:    return "dfs";
+        case VertexOrder::None:
+        default:                  return "none";
+    }
+}
+
+/**
+ * @brief Appends the BFS order of root's component to order. With
+ * byDegree, each vertex's unvisited neighbors are queued by increasing
+ * degree (Cuthill-McKee).
+ */
+template <typename Id>
+void appendBFSOrder(const BasicCSRGraph<Id>& g, Id root, bool byDegree,
+                    std::vector<char>& visited, std::vector<Id>& order) {
+    size_t head = order.size();
+    order.push_back(root);
+    visited[root] = 1;
+    while (head < order.size()) {
+        Id u = order[head++];
+        size_t first = order.size();
+        for (Id v : g.neighborsOf(u)) {
+            if (!visited[v]) {
+                visited[v] = 1;
+                order.push_back(v);
+            }
+        }
+        if (byDegree) {
+            std::stable_sort(order.begin() + first, order.end(),
+                             [&](Id a, Id b) { return g.degree(a) < g.degree(b); });
+        }
+    }
+}
+
+// IterativeDFS visitor recording the preorder
+template <typename Id>
+struct PreorderRecorder {
+    std::vector<char>& visited;
+    std::vector<Id>& order;
+    void discover(Id u) {
+        visited[u] = 1;
+        order.push_back(u);
+    }
+    bool edge(Id, Id v, Id) { return !visited[v]; }
+    void retreat(Id, Id, Id) {}
+    void finish(Id) {}
+};
+
+/**
+ * @brief New-to-old vertex permutation of g for the given order.
+ */
+template <typename Id>
+std::vector<Id> computeVertexOrder(const BasicCSRGraph<Id>& g, VertexOrder which) {
+    std::vector<Id> order;
+    order.reserve(g.V);
+    std::vector<char> visited(g.V, 0);
+
+    switch (which) {
+        case VertexOrder::BFS:
+            for (Id v = 0; v < g.V; ++v) {
+                if (!visited[v]) appendBFSOrder(g, v, false, visited, order);
+            }
+            break;
+        case VertexOrder::RCM: {
+            // Start every component at its lowest-degree vertex
+            std::vector<Id> byDegree(g.V);
+            std::iota(byDegree.begin(), byDegree.end(), 0);
+            std::stable_sort(byDegree.begin(), byDegree.end(),
+                             [&](Id a, Id b) { return g.degree(a) < g.degree(b); });
+            for (Id v : byDegree) {
+                if (!visited[v]) appendBFSOrder(g, v, true, visited, order);
+            }
+            std::reverse(order.begin(), order.end());
+            break;
+        }
+        case VertexOrder::Degree:
+            order.resize(g.V);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(),
+                             [&](Id a, Id b) { return g.degree(a) > g.degree(b); });
+            break;
+        case VertexOrder::DFS: {
+            BasicIterativeDFS<Id> dfs(g.V);
+            PreorderRecorder<Id> recorder{visited, order};
+            for (Id v = 0; v < g.V; ++v) {
+                if (!visited[v]) dfs.run(g, v, recorder);
+            }
+            break;
+        }
+        case VertexOrder::None:
+        default:
+            order.resize(g.V);
+            std::iota(order.begin(), order.end(), 0);
+            break;
+    }
+    return order;
+}
+
+/**
+ * @brief A renumbered copy of a graph and the maps between the numberings.
+ */
+template <typename Id>
+struct Reordering {
+    VertexOrder order = VertexOrder::None;
+    std::vector<Id> newToOld, oldToNew;
+    BasicCSRGraph<Id> graph; // vertex x of graph is vertex newToOld[x] of the input
+    double seconds = 0;      // time to compute the order and rebuild the CSR
+};
+
+/**
+ * @brief Renumbers g by `order`. Each vertex keeps its neighbors in input
+ * order and every edge keeps its id, so edge labels need no translation.
+ */
+template <typename Id>
+Reordering<Id> reorderGraph(const BasicCSRGraph<Id>& g, VertexOrder order) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Reordering<Id> ro;
+    ro.order = order;
+    ro.newToOld = computeVertexOrder(g, order);
+    ro.oldToNew.assign(g.V, -1);
+    for (Id x = 0; x < g.V; ++x) ro.oldToNew[ro.newToOld[x]] = x;
+
+    std::vector<Id> edgeIds = csrEdgeIds(g);
+    BasicCSRGraph<Id>& h = ro.graph;
+    h.V = g.V;
+    h.E = g.E;
+    h.offsetStore.assign(g.V + 1, 0);
+    h.neighborStore.resize(g.offsets[g.V]);
+    h.edgeIdStore.resize(g.offsets[g.V]);
+    for (Id x = 0; x < g.V; ++x) {
+        Id u = ro.newToOld[x];
+        Id out = h.offsetStore[x];
+        for (Id i = g.offsets[u]; i < g.offsets[u + 1]; ++i, ++out) {
+            h.neighborStore[out] = ro.oldToNew[g.neighbors[i]];
+            h.edgeIdStore[out] = edgeIds[i];
+        }
+        h.offsetStore[x + 1] = out;
+    }
+    h.offsets = h.offsetStore.data();
+    h.neighbors = h.neighborStore.data();
+    h.edgeIds = h.edgeIdStore.data();
+
+    ro.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return ro;
+}
+
+/**
+ * @brief Maps a result computed on ro.graph back to the input ids. BCCs
+ * keep their order; with canonicalEdges each BCC's edges are made (min,
+ * max) again and re-sorted, as the engine reported them.
+ */
+template <typename Id>
+void restoreOriginalIds(BasicBCCResult<Id>& r, const Reordering<Id>& ro, bool canonicalEdges) {
+    for (auto& edge : r.bccEdges) {
+        edge.first = ro.newToOld[edge.first];
+        edge.second = ro.newToOld[edge.second];
+        if (canonicalEdges && edge.first > edge.second) std::swap(edge.first, edge.second);
+    }
+    if (canonicalEdges) {
+        for (Id i = 0; i < r.numBCCs(); ++i) {
+            std::sort(r.bccEdges.begin() + r.bccOffsets[i], r.bccEdges.begin() + r.bccOffsets[i + 1]);
+        }
+    }
+
+    std::vector<char> isArticulation(ro.newToOld.size(), 0);
+    for (Id x : r.articulationPoints) isArticulation[ro.newToOld[x]] = 1;
+    r.setArticulationPoints(isArticulation);
+}
+
+/**
+ * @brief Runs engine(graph) on g, renumbered by `order` unless it is None,
+ * and returns the result in g's ids with the reordering time recorded.
+ * canonicalEdges says whether the engine reports sorted (min, max) edges.
+ */
+template <typename Id, typename Engine>
+BasicBCCResult<Id> computeReordered(const BasicCSRGraph<Id>& g, VertexOrder order, bool canonicalEdges,
+                                    Engine engine) {
+    if (order == VertexOrder::None) return engine(g);
+    Reordering<Id> ro = reorderGraph(g, order);
+    BasicBCCResult<Id> result = engine(ro.graph);
+    restoreOriginalIds(result, ro, canonicalEdges);
+    result.reorderSeconds = ro.seconds;
+    return result;
+}
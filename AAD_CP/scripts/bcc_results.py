@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Loader for the machine-readable results written by p1 - p5 with
+--format=json or --format=bin (layout documented in codes/result_output.h).
+
+    from bcc_results import load_results
+    r = load_results('outputs/p1_git.bin')
+    r['edge_to_bcc'][e]        # BCC label of edge e (-1: in no BCC), None for p4
+    r['articulation_points']   # sorted list of cut vertices
+
+Usage: python3 bcc_results.py result.bin|result.json   (prints a summary)
+"""
+
+import json
+import struct
+import sys
+from array import array
+
+RESULT_MAGIC = b'BCCRES\x00\x01'
+HEADER = struct.Struct('<8sIIQQqQdd32s')  # ResultFileHeader, 96 bytes
+HAS_BCCS = 1
+WIDE_LABELS = 2  # version 2: int64 labels (graphs with 64-bit ids)
+
+
+def _bitmap_to_points(bitmap: bytes, n: int):
+    points = []
+    for i, byte in enumerate(bitmap):
+        while byte:
+            low = byte & -byte
+            v = 8 * i + low.bit_length() - 1
+            if v < n:
+                points.append(v)
+            byte ^= low
+    return points
+
+
+def load_results(path):
+    """Return a dict with algorithm, vertices, edges, bccs, edge_to_bcc,
+       articulation_points and timing, from either result format."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data.startswith(RESULT_MAGIC):
+        (_, version, flags, n, m, bccs, num_aps,
+         load_s, compute_s, algorithm) = HEADER.unpack_from(data, 0)
+        if version not in (1, 2):
+            raise ValueError(f'{path}: unsupported result version {version}')
+        pos = HEADER.size
+        edge_to_bcc = None
+        if flags & HAS_BCCS:
+            width = 8 if flags & WIDE_LABELS else 4
+            edge_to_bcc = array('q' if width == 8 else 'i')
+            edge_to_bcc.frombytes(data[pos:pos + width * m])
+            if sys.byteorder != 'little':
+                edge_to_bcc.byteswap()
+            pos += (width * m + 7) & ~7
+        else:
+            bccs = None
+        bitmap = data[pos:pos + 8 * ((n + 63) // 64)]
+        algorithm = algorithm.rstrip(b'\x00').decode()
+    else:
+        doc = json.loads(data)
+        n, m, bccs = doc['vertices'], doc['edges'], doc['bccs']
+        labels = doc['edgeToBCC']
+        edge_to_bcc = None if labels is None else array('q' if m > 2**31 - 1 else 'i', labels)
+        bitmap = bytes.fromhex(doc['articulationBitmap'])
+        num_aps = doc['articulationPoints']
+        load_s = doc['timing']['loadSeconds']
+        compute_s = doc['timing']['computeSeconds']
+        algorithm = doc['algorithm']
+
+    points = _bitmap_to_points(bitmap, n)
+    assert len(points) == num_aps, f'{path}: bitmap does not match AP count'
+    return {'algorithm': algorithm, 'vertices': n, 'edges': m, 'bccs': bccs,
+            'edge_to_bcc': edge_to_bcc, 'articulation_points': points,
+            'timing': {'load_seconds': load_s, 'compute_seconds': compute_s}}
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        print(f'Usage: {sys.argv[0]} result.bin|result.json')
+        sys.exit(1)
+    r = load_results(sys.argv[1])
+    print(f"{r['algorithm']}: {r['vertices']} vertices, {r['edges']} edges, "
+          f"{'n/a' if r['bccs'] is None else r['bccs']} BCCs, "
+          f"{len(r['articulation_points'])} articulation points, "
+          f"compute {r['timing']['compute_seconds']:.6f}s")
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+Regression check: the text report and --format=summary of every engine
+must agree on the BCC count, the bridges and the largest BCC. A BCC's
+size is its number of distinct edges (parallel copies once), as in
+codes/bcc_summary.h. Also queries bcc_server on a graph with a doubled
+edge and an isolated vertex.
+
+Usage: python3 check_outputs.py [graph.txt ...]   (default: small_11, the
+       doubled-edge multigraph)
+Exits 1 and lists the mismatches if any engine disagrees with itself.
+"""
+
+import re
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[1]
+CODES_DIR = ROOT / 'codes'
+DEFAULT_GRAPHS = [ROOT / 'dataset' / 'small' / 'small_11.txt']
+# (program, extra flags); p4 finds articulation points only
+RUNS = [('p1', []), ('p1', ['--no-edge-stack']), ('p2', []), ('p3', []),
+        ('p3', ['--no-edge-stack']), ('p5', []), ('p5', ['--no-edge-stack'])]
+
+BCC_LINE = re.compile(r'^BCC \d+ .*?\{(.*)\}$')
+PAIR = re.compile(r'\((\d+), (\d+)\)')
+
+
+# Vertex 3 is isolated; 0-1 is doubled, 1-2 is a plain bridge
+SERVER_GRAPH = "4 3\n0 1\n0 1\n1 2\n"
+SERVER_QUERIES = [('SAME 3 3', '0'), ('SAME 0 0', '1'), ('SAME 0 2', '0'),
+                  ('BRIDGE 0 1', '1'), ('BRIDGE 1 2', '1'), ('AP 1', '1'), ('AP 3', '0')]
+
+
+def compile_if_needed(name: str):
+    exe = CODES_DIR / name
+    src = CODES_DIR / f"{name}.cpp"
+    if exe.exists() and exe.stat().st_mtime >= src.stat().st_mtime:
+        return exe
+    r = subprocess.run(['g++', str(src), '-O2', '-std=c++17', '-fopenmp', '-pthread', '-o', str(exe)],
+                       capture_output=True, text=True)
+    if r.returncode != 0:
+        sys.exit(f"Compilation failed for {name}:\n{r.stderr}")
+    return exe
+
+
+def text_counts(output: str):
+    """(bccs, bridges, largest) from a text report."""
+    sizes = []
+    for line in output.splitlines():
+        m = BCC_LINE.match(line.strip())
+        if m:
+            pairs = {(min(int(a), int(b)), max(int(a), int(b))) for a, b in PAIR.findall(m.group(1))}
+            sizes.append(len(pairs))
+    return len(sizes), sizes.count(1), max(sizes, default=0)
+
+
+def summary_counts(output: str):
+    """(bccs, bridges, largest) from a --format=summary report."""
+    def field(name):
+        m = re.search(re.escape(name) + r': (\d+)', output)
+        return int(m.group(1)) if m else 0
+    return (field('Total Biconnected Components (BCCs) found'), field('Bridges'),
+            field('Largest BCC (edges)'))
+
+
+def check_server():
+    """Number of wrong answers from bcc_server on SERVER_GRAPH."""
+    exe = compile_if_needed('bcc_server')
+    failures = 0
+    with tempfile.TemporaryDirectory() as tmp:
+        graph, sock = Path(tmp) / 'graph.txt', Path(tmp) / 'bcc.sock'
+        graph.write_text(SERVER_GRAPH)
+        server = subprocess.Popen([str(exe), str(graph), f'--socket={sock}'], stderr=subprocess.DEVNULL)
+        try:
+            for _ in range(100):
+                if sock.exists():
+                    break
+                time.sleep(0.05)
+            with socket.socket(socket.AF_UNIX) as s:
+                s.connect(str(sock))
+                replies = s.makefile('r')
+                for query, expected in SERVER_QUERIES:
+                    s.sendall((query + '\n').encode())
+                    answer = replies.readline().strip()
+                    if answer != expected:
+                        failures += 1
+                        print(f"MISMATCH bcc_server {query}: {answer} (expected {expected})")
+                    else:
+                        print(f"ok bcc_server {query}: {answer}")
+                s.sendall(b'SHUTDOWN\n')
+        finally:
+            server.wait(timeout=5)
+    return failures
+
+
+def main():
+    graphs = [Path(a) for a in sys.argv[1:]] or DEFAULT_GRAPHS
+    failures = 0
+    for prog, flags in RUNS:
+        exe = compile_if_needed(prog)
+        for graph in graphs:
+            run = lambda extra: subprocess.run([str(exe), str(graph)] + flags + extra,
+                                               capture_output=True, text=True, check=True).stdout
+            text, summary = text_counts(run([])), summary_counts(run(['--format=summary']))
+            label = ' '.join([prog] + flags)
+            if text != summary:
+                failures += 1
+                print(f"MISMATCH {label} {graph.name}: text {text} vs summary {summary}")
+            else:
+                print(f"ok {label} {graph.name}: bccs={text[0]} bridges={text[1]} largest={text[2]}")
+    failures += check_server()
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == '__main__':
+    main()
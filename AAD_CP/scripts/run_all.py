@@ -177,10 +177,10 @@ def run():
             out_subdir.mkdir(parents=True, exist_ok=True)
             outfile = out_subdir / fpath.name
 
-            # run with redirected stdin from dataset file
+            # pass the dataset path so the program can mmap it directly
             start = time.perf_counter()
             try:
-                p = subprocess.run([str(exe_path)], stdin=open(fpath,'r'), 
+                p = subprocess.run([str(exe_path), str(fpath)], 
                                  stdout=subprocess.PIPE, stderr=subprocess.STDOUT, 
                                  timeout=600)
                 end = time.perf_counter()